@@ -0,0 +1,795 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  spvgenBench.cpp
+* @brief SPVGEN benchmark: runs a corpus of GLSL/HLSL/SPIR-V files through the exported entry-points of SPVGEN, and
+*        reports throughput, latency percentiles and the scaling across client threads.
+***********************************************************************************************************************
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Load SPVGEN dynamically through the entry-point table, the same way as the clients of the library do
+#define SPVGEN_STATIC_LIB
+#include "spvgen.h"
+
+// Operations measured by the benchmark
+enum BenchOp : uint32_t
+{
+    BenchOpCompile,
+    BenchOpAssemble,
+    BenchOpDisassemble,
+    BenchOpValidate,
+    BenchOpOptimize,
+    BenchOpCrossGlsl,
+    BenchOpCrossHlsl,
+    BenchOpCrossMsl,
+    BenchOpCount,
+};
+
+static const char* const BenchOpNames[BenchOpCount] =
+{
+    "compile",
+    "assemble",
+    "disassemble",
+    "validate",
+    "optimize",
+    "cross-glsl",
+    "cross-hlsl",
+    "cross-msl",
+};
+
+// Shader source to compile
+struct SourceItem
+{
+    std::string  fileName;
+    std::string  source;
+    SpvGenStage  stage;
+    int          options;
+};
+
+// SPIR-V binary, either read from the corpus or produced while preparing the benchmark
+struct BinaryItem
+{
+    std::string               name;
+    std::vector<unsigned int> spirv;
+};
+
+// SPIR-V text, either read from the corpus or produced while preparing the benchmark
+struct TextItem
+{
+    std::string name;
+    std::string text;
+};
+
+// Inputs of all operations
+struct BenchCorpus
+{
+    std::vector<SourceItem> sources;
+    std::vector<TextItem>   texts;
+    std::vector<BinaryItem> binaries;
+    size_t                  maxBinarySize = 0;
+    size_t                  maxTextSize = 0;
+};
+
+// Result of one operation with one thread count
+struct BenchResult
+{
+    BenchOp  op;
+    uint32_t threadCount;
+    uint64_t itemCount;
+    uint64_t failureCount;
+    uint64_t inputBytes;
+    double   wallTime;    // Seconds
+    double   p50;         // Latency percentiles in milliseconds
+    double   p90;
+    double   p99;
+    double   max;
+};
+
+// Command-line options
+struct BenchOptions
+{
+    std::string corpusDir;
+    std::string libDir;
+    uint32_t    maxThreadCount = 0;
+    uint32_t    iterationCount = 1;
+    bool        json = false;
+    bool        opEnabled[BenchOpCount] = {};
+};
+
+// Size of the log buffers passed to SPVGEN
+static const unsigned int LogSize = 4096;
+
+// =====================================================================================================================
+// Read the whole content of a file, returns false if it can't be read
+static bool ReadFile(
+    const std::filesystem::path& path,
+    std::string*                 pData)   // [out] Content of the file
+{
+    std::ifstream file(path, std::ios::binary);
+    if (file.good() == false)
+    {
+        return false;
+    }
+    pData->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// =====================================================================================================================
+// Collect the files of the corpus directory: GLSL/HLSL sources are recognized by spvGetStageTypeFromName, SPIR-V
+// binaries by the .spv extension and SPIR-V text by the .spvasm extension. Other files are ignored.
+static void LoadCorpus(
+    const std::string& corpusDir,
+    BenchCorpus*       pCorpus)   // [out] Loaded corpus
+{
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(corpusDir))
+    {
+        if (entry.is_regular_file())
+        {
+            paths.push_back(entry.path());
+        }
+    }
+
+    // Keep the order stable between runs
+    std::sort(paths.begin(), paths.end());
+
+    for (const auto& path : paths)
+    {
+        const std::string fileName = path.string();
+        const std::string extension = path.extension().string();
+        std::string data;
+
+        if (extension == ".spv")
+        {
+            if (ReadFile(path, &data) && (data.size() >= 20) && (data.size() % sizeof(unsigned int) == 0))
+            {
+                BinaryItem item;
+                item.name = fileName;
+                item.spirv.resize(data.size() / sizeof(unsigned int));
+                memcpy(item.spirv.data(), data.data(), data.size());
+                pCorpus->binaries.push_back(std::move(item));
+            }
+        }
+        else if (extension == ".spvasm")
+        {
+            if (ReadFile(path, &data))
+            {
+                pCorpus->texts.push_back({ fileName, std::move(data) });
+            }
+        }
+        else
+        {
+            bool isHlsl = false;
+            SpvGenStage stage = spvGetStageTypeFromName(fileName.c_str(), &isHlsl);
+            if ((stage != SpvGenStageInvalid) && ReadFile(path, &data))
+            {
+                int options = SpvGenOptionDefaultDesktop | SpvGenOptionVulkanRules;
+                if (isHlsl)
+                {
+                    options |= SpvGenOptionReadHlsl;
+                }
+                pCorpus->sources.push_back({ fileName, std::move(data), stage, options });
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Compile one source item, returns false on failure
+static bool CompileSource(
+    const SourceItem&          item,
+    std::vector<unsigned int>* pSpirv)   // [out] SPIR-V binary, may be null
+{
+    const char* pSource = item.source.c_str();
+    const char* pFileName = item.fileName.c_str();
+    const char* const* sourceList[] = { &pSource };
+    const char* const* fileList[] = { &pFileName };
+    const int sourceCount = 1;
+    void* hProgram = nullptr;
+    const char* pLog = nullptr;
+
+    bool success = spvCompileAndLinkProgramEx(1,
+                                              &item.stage,
+                                              &sourceCount,
+                                              sourceList,
+                                              fileList,
+                                              nullptr,
+                                              &hProgram,
+                                              &pLog,
+                                              item.options);
+    if (success && (pSpirv != nullptr))
+    {
+        const unsigned int* pData = nullptr;
+        int size = spvGetSpirvBinaryFromProgram(hProgram, 0, &pData);
+        pSpirv->assign(pData, pData + size / sizeof(unsigned int));
+    }
+
+    if (hProgram != nullptr)
+    {
+        spvDestroyProgram(hProgram);
+    }
+    return success;
+}
+
+// =====================================================================================================================
+// Get the size of the disassembly buffer for a SPIR-V binary of the specified size
+static size_t GetDisassemblyBufferSize(
+    size_t binarySize)   // Size of the SPIR-V binary in bytes
+{
+    // spvDisassembleSpirv doesn't clamp its output, the text is much smaller than this in practice
+    return binarySize * 32 + 65536;
+}
+
+// =====================================================================================================================
+// Compile the sources and convert between binary and text once, so that every operation has as much input as the
+// corpus allows. This also warms up the library.
+static void PrepareCorpus(
+    BenchCorpus* pCorpus)   // [in, out] Corpus
+{
+    for (const SourceItem& item : pCorpus->sources)
+    {
+        BinaryItem binary;
+        binary.name = item.fileName;
+        if (CompileSource(item, &binary.spirv) && (binary.spirv.empty() == false))
+        {
+            pCorpus->binaries.push_back(std::move(binary));
+        }
+        else
+        {
+            fprintf(stderr, "warning: failed to compile %s\n", item.fileName.c_str());
+        }
+    }
+
+    const size_t assembledBase = pCorpus->binaries.size();
+    for (const TextItem& item : pCorpus->texts)
+    {
+        std::vector<unsigned int> buffer(item.text.size() + 1024);
+        const char* pLog = nullptr;
+        int size = spvAssembleSpirv(item.text.c_str(),
+                                    static_cast<unsigned int>(buffer.size() * sizeof(unsigned int)),
+                                    buffer.data(),
+                                    &pLog);
+        if (size > 0)
+        {
+            buffer.resize(size / sizeof(unsigned int));
+            pCorpus->binaries.push_back({ item.name, std::move(buffer) });
+        }
+        else
+        {
+            fprintf(stderr, "warning: failed to assemble %s\n", item.name.c_str());
+        }
+    }
+
+    // Disassemble the binaries which don't come from a text file, to give the assembler more input
+    for (size_t i = 0; i < assembledBase; ++i)
+    {
+        const BinaryItem& item = pCorpus->binaries[i];
+        const size_t binarySize = item.spirv.size() * sizeof(unsigned int);
+        std::vector<char> buffer(GetDisassemblyBufferSize(binarySize));
+        if (spvDisassembleSpirv(static_cast<unsigned int>(binarySize),
+                                item.spirv.data(),
+                                static_cast<unsigned int>(buffer.size()),
+                                buffer.data()))
+        {
+            pCorpus->texts.push_back({ item.name + ".spvasm", buffer.data() });
+        }
+    }
+
+    for (const BinaryItem& item : pCorpus->binaries)
+    {
+        pCorpus->maxBinarySize = std::max(pCorpus->maxBinarySize, item.spirv.size() * sizeof(unsigned int));
+    }
+    for (const TextItem& item : pCorpus->texts)
+    {
+        pCorpus->maxTextSize = std::max(pCorpus->maxTextSize, item.text.size());
+    }
+}
+
+// =====================================================================================================================
+// Get the number of input items of an operation
+static size_t GetItemCount(
+    const BenchCorpus& corpus,
+    BenchOp            op)
+{
+    switch (op)
+    {
+    case BenchOpCompile:
+        return corpus.sources.size();
+    case BenchOpAssemble:
+        return corpus.texts.size();
+    default:
+        return corpus.binaries.size();
+    }
+}
+
+// =====================================================================================================================
+// Per-thread scratch buffers, they are reused across the items to keep allocations out of the measurement
+struct ScratchBuffers
+{
+    std::vector<unsigned int> binary;
+    std::vector<char>         text;
+    char                      log[LogSize];
+};
+
+// =====================================================================================================================
+// Run one operation on one item, returns false on failure
+static bool RunItem(
+    const BenchCorpus& corpus,
+    BenchOp            op,
+    size_t             index,       // Index of the item
+    ScratchBuffers*    pScratch,    // [in, out] Scratch buffers of the calling thread
+    uint64_t*          pInputSize)  // [out] Size of the input in bytes
+{
+    if (op == BenchOpCompile)
+    {
+        const SourceItem& item = corpus.sources[index];
+        *pInputSize = item.source.size();
+        return CompileSource(item, nullptr);
+    }
+
+    if (op == BenchOpAssemble)
+    {
+        const TextItem& item = corpus.texts[index];
+        *pInputSize = item.text.size();
+        const char* pLog = nullptr;
+        return spvAssembleSpirv(item.text.c_str(),
+                                static_cast<unsigned int>(pScratch->binary.size() * sizeof(unsigned int)),
+                                pScratch->binary.data(),
+                                &pLog) > 0;
+    }
+
+    const BinaryItem& item = corpus.binaries[index];
+    const unsigned int size = static_cast<unsigned int>(item.spirv.size() * sizeof(unsigned int));
+    *pInputSize = size;
+
+    bool success = false;
+    switch (op)
+    {
+    case BenchOpDisassemble:
+        {
+            success = spvDisassembleSpirv(size,
+                                          item.spirv.data(),
+                                          static_cast<unsigned int>(pScratch->text.size()),
+                                          pScratch->text.data());
+            break;
+        }
+    case BenchOpValidate:
+        {
+            success = spvValidateSpirv(size, item.spirv.data(), LogSize, pScratch->log);
+            break;
+        }
+    case BenchOpOptimize:
+        {
+            unsigned int optSize = 0;
+            void* pOptBuf = nullptr;
+            success = spvOptimizeSpirv(size, item.spirv.data(), 0, nullptr, &optSize, &pOptBuf, LogSize, pScratch->log);
+            spvFreeBuffer(pOptBuf);
+            break;
+        }
+    case BenchOpCrossGlsl:
+    case BenchOpCrossHlsl:
+    case BenchOpCrossMsl:
+        {
+            SpvSourceLanguage language = (op == BenchOpCrossGlsl) ? SpvSourceLanguageVulkan :
+                                         (op == BenchOpCrossHlsl) ? SpvSourceLanguageHLSL : SpvSourceLanguageMSL;
+            char* pSource = nullptr;
+            success = spvCrossSpirvEx(language, 0, size, item.spirv.data(), &pSource);
+            spvFreeBuffer(pSource);
+            break;
+        }
+    default:
+        break;
+    }
+    return success;
+}
+
+// =====================================================================================================================
+// Get a percentile of sorted latencies in milliseconds
+static double GetPercentile(
+    const std::vector<uint64_t>& sortedLatencies,   // [in] Latencies in nanoseconds, sorted
+    double                       percentile)        // Percentile in [0, 1]
+{
+    if (sortedLatencies.empty())
+    {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(percentile * static_cast<double>(sortedLatencies.size()));
+    index = std::min(index, sortedLatencies.size() - 1);
+    return static_cast<double>(sortedLatencies[index]) / 1e6;
+}
+
+// =====================================================================================================================
+// Run one operation over the whole corpus with the specified number of client threads
+static BenchResult RunOp(
+    const BenchCorpus&  corpus,
+    const BenchOptions& options,
+    BenchOp             op,
+    uint32_t            threadCount)
+{
+    const size_t itemCount = GetItemCount(corpus, op);
+    const size_t totalCount = itemCount * options.iterationCount;
+
+    std::atomic<size_t>   nextItem(0);
+    std::atomic<uint64_t> failureCount(0);
+    std::atomic<uint64_t> inputBytes(0);
+    std::vector<std::vector<uint64_t>> latencies(threadCount);
+
+    auto worker = [&](uint32_t threadIndex)
+    {
+        ScratchBuffers scratch;
+        scratch.binary.resize(corpus.maxTextSize / sizeof(unsigned int) + 1024);
+        scratch.text.resize(GetDisassemblyBufferSize(corpus.maxBinarySize));
+        latencies[threadIndex].reserve(totalCount / threadCount + 1);
+
+        for (size_t i = nextItem++; i < totalCount; i = nextItem++)
+        {
+            uint64_t inputSize = 0;
+            auto startTime = std::chrono::steady_clock::now();
+            bool success = RunItem(corpus, op, i % itemCount, &scratch, &inputSize);
+            auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+            latencies[threadIndex].push_back(
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            inputBytes += inputSize;
+            if (success == false)
+            {
+                ++failureCount;
+            }
+        }
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < threadCount; ++i)
+    {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - startTime;
+
+    std::vector<uint64_t> allLatencies;
+    allLatencies.reserve(totalCount);
+    for (const auto& threadLatencies : latencies)
+    {
+        allLatencies.insert(allLatencies.end(), threadLatencies.begin(), threadLatencies.end());
+    }
+    std::sort(allLatencies.begin(), allLatencies.end());
+
+    BenchResult result = {};
+    result.op           = op;
+    result.threadCount  = threadCount;
+    result.itemCount    = totalCount;
+    result.failureCount = failureCount;
+    result.inputBytes   = inputBytes;
+    result.wallTime     = wallTime.count();
+    result.p50          = GetPercentile(allLatencies, 0.50);
+    result.p90          = GetPercentile(allLatencies, 0.90);
+    result.p99          = GetPercentile(allLatencies, 0.99);
+    result.max          = allLatencies.empty() ? 0.0 : static_cast<double>(allLatencies.back()) / 1e6;
+    return result;
+}
+
+// =====================================================================================================================
+// Escape a string for JSON output
+static std::string JsonEscape(
+    const std::string& text)
+{
+    std::string escaped;
+    for (char c : text)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            escaped += buffer;
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// =====================================================================================================================
+// Print the results as a human readable table
+static void PrintText(
+    const BenchCorpus&              corpus,
+    const std::vector<BenchResult>& results)
+{
+    printf("corpus: %zu sources, %zu SPIR-V texts, %zu SPIR-V binaries\n\n",
+           corpus.sources.size(),
+           corpus.texts.size(),
+           corpus.binaries.size());
+    printf("%-12s %7s %8s %8s %10s %9s %9s %9s %9s %9s\n",
+           "operation", "threads", "items", "failed", "items/s", "MB/s", "p50 ms", "p90 ms", "p99 ms", "max ms");
+
+    for (const BenchResult& result : results)
+    {
+        const double wallTime = std::max(result.wallTime, 1e-9);
+        printf("%-12s %7u %8llu %8llu %10.1f %9.2f %9.3f %9.3f %9.3f %9.3f\n",
+               BenchOpNames[result.op],
+               result.threadCount,
+               static_cast<unsigned long long>(result.itemCount),
+               static_cast<unsigned long long>(result.failureCount),
+               static_cast<double>(result.itemCount) / wallTime,
+               static_cast<double>(result.inputBytes) / (1024.0 * 1024.0) / wallTime,
+               result.p50,
+               result.p90,
+               result.p99,
+               result.max);
+    }
+}
+
+// =====================================================================================================================
+// Print the results as JSON, including the component versions so that results of different builds can be compared
+static void PrintJson(
+    const BenchOptions&             options,
+    const BenchCorpus&              corpus,
+    const std::vector<BenchResult>& results)
+{
+    static const char* const VersionNames[SpvGenVersionCount] =
+    {
+        "glslang",
+        "spirv",
+        "std450",
+        "extAmd",
+        "spvgen",
+    };
+
+    printf("{\n  \"corpus\": \"%s\",\n", JsonEscape(options.corpusDir).c_str());
+    printf("  \"sourceCount\": %zu,\n  \"textCount\": %zu,\n  \"binaryCount\": %zu,\n",
+           corpus.sources.size(),
+           corpus.texts.size(),
+           corpus.binaries.size());
+    printf("  \"iterations\": %u,\n", options.iterationCount);
+
+    printf("  \"versions\": {");
+    for (uint32_t i = 0; i < SpvGenVersionCount; ++i)
+    {
+        unsigned int version = 0;
+        unsigned int revision = 0;
+        spvGetVersion(static_cast<SpvGenVersion>(i), &version, &revision);
+        printf("%s\"%s\": [%u, %u]", (i == 0) ? " " : ", ", VersionNames[i], version, revision);
+    }
+    printf(" },\n");
+
+    printf("  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult& result = results[i];
+        const double wallTime = std::max(result.wallTime, 1e-9);
+        printf("    { \"operation\": \"%s\", \"threads\": %u, \"items\": %llu, \"failures\": %llu, "
+               "\"inputBytes\": %llu, \"wallTime\": %.6f, \"itemsPerSecond\": %.3f, \"megabytesPerSecond\": %.3f, "
+               "\"p50\": %.6f, \"p90\": %.6f, \"p99\": %.6f, \"max\": %.6f }%s\n",
+               BenchOpNames[result.op],
+               result.threadCount,
+               static_cast<unsigned long long>(result.itemCount),
+               static_cast<unsigned long long>(result.failureCount),
+               static_cast<unsigned long long>(result.inputBytes),
+               result.wallTime,
+               static_cast<double>(result.itemCount) / wallTime,
+               static_cast<double>(result.inputBytes) / (1024.0 * 1024.0) / wallTime,
+               result.p50,
+               result.p90,
+               result.p99,
+               result.max,
+               (i + 1 < results.size()) ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+// =====================================================================================================================
+static void PrintUsage()
+{
+    printf("Usage: spvgen_bench [options] <corpus directory>\n"
+           "\n"
+           "Runs every GLSL/HLSL source (*.vert, *.frag.hlsl, ...), SPIR-V binary (*.spv) and SPIR-V text (*.spvasm)\n"
+           "in the corpus directory through the SPVGEN entry-points.\n"
+           "\n"
+           "Options:\n"
+           "  --threads <n>      Maximum number of client threads, scaling is measured with 1, 2, 4, ... n threads\n"
+           "                     (default: number of hardware threads)\n"
+           "  --iterations <n>   Number of passes over the corpus per measurement (default: 1)\n"
+           "  --ops <list>       Comma-separated operations to run (default: all):\n"
+           "                     compile, assemble, disassemble, validate, optimize, cross-glsl, cross-hlsl, cross-msl\n"
+           "  --lib-dir <dir>    Directory to load the SPVGEN library from (default: directory of this executable)\n"
+           "  --json             Print machine-readable results\n");
+}
+
+// =====================================================================================================================
+// Parse the command-line options, returns false if they are invalid
+static bool ParseOptions(
+    int           argc,
+    char*         argv[],
+    BenchOptions* pOptions)   // [out] Parsed options
+{
+    bool hasOps = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+
+        if ((arg == "--threads") && hasValue)
+        {
+            pOptions->maxThreadCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((arg == "--iterations") && hasValue)
+        {
+            pOptions->iterationCount = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+        }
+        else if ((arg == "--lib-dir") && hasValue)
+        {
+            pOptions->libDir = argv[++i];
+        }
+        else if ((arg == "--ops") && hasValue)
+        {
+            hasOps = true;
+            std::string list = argv[++i];
+            size_t start = 0;
+            while (start <= list.size())
+            {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos)
+                {
+                    end = list.size();
+                }
+
+                const std::string name = list.substr(start, end - start);
+                const auto pName = std::find_if(std::begin(BenchOpNames),
+                                                std::end(BenchOpNames),
+                                                [&](const char* pOpName) { return name == pOpName; });
+                if (pName == std::end(BenchOpNames))
+                {
+                    fprintf(stderr, "error: unknown operation '%s'\n", name.c_str());
+                    return false;
+                }
+                pOptions->opEnabled[pName - std::begin(BenchOpNames)] = true;
+                start = end + 1;
+            }
+        }
+        else if (arg == "--json")
+        {
+            pOptions->json = true;
+        }
+        else if ((arg[0] != '-') && pOptions->corpusDir.empty())
+        {
+            pOptions->corpusDir = arg;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (hasOps == false)
+    {
+        std::fill(std::begin(pOptions->opEnabled), std::end(pOptions->opEnabled), true);
+    }
+
+    if (pOptions->maxThreadCount == 0)
+    {
+        pOptions->maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (pOptions->libDir.empty())
+    {
+        pOptions->libDir = std::filesystem::path(argv[0]).parent_path().string();
+    }
+
+    return pOptions->corpusDir.empty() == false;
+}
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    BenchOptions options;
+    if (ParseOptions(argc, argv, &options) == false)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (InitSpvGen(options.libDir.empty() ? nullptr : options.libDir.c_str()) == false)
+    {
+        fprintf(stderr, "error: failed to load SPVGEN\n");
+        return 1;
+    }
+
+    BenchCorpus corpus;
+    try
+    {
+        LoadCorpus(options.corpusDir, &corpus);
+    }
+    catch (const std::filesystem::filesystem_error& e)
+    {
+        fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    PrepareCorpus(&corpus);
+
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threadCount = 1; threadCount < options.maxThreadCount; threadCount *= 2)
+    {
+        threadCounts.push_back(threadCount);
+    }
+    threadCounts.push_back(options.maxThreadCount);
+
+    std::vector<BenchResult> results;
+    for (uint32_t op = 0; op < BenchOpCount; ++op)
+    {
+        if ((options.opEnabled[op] == false) || (GetItemCount(corpus, static_cast<BenchOp>(op)) == 0))
+        {
+            continue;
+        }
+
+        // Untimed pass, so that lazily built state of the libraries doesn't end up in the first measurement
+        BenchOptions warmupOptions = options;
+        warmupOptions.iterationCount = 1;
+        RunOp(corpus, warmupOptions, static_cast<BenchOp>(op), 1);
+
+        for (uint32_t threadCount : threadCounts)
+        {
+            results.push_back(RunOp(corpus, options, static_cast<BenchOp>(op), threadCount));
+        }
+    }
+
+    if (options.json)
+    {
+        PrintJson(options, corpus, results);
+    }
+    else
+    {
+        PrintText(corpus, results);
+    }
+
+    FinalizeSpvgen();
+    return 0;
+}
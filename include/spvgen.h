@@ -82,7 +82,9 @@ enum SpvGenOptions : uint32_t
     SpvGenOptionInvertY              = (1 << 11),
     SpvGenOptionSuppressInfolog      = (1 << 12),
     SpvGenOptionHlslDX9compatible    = (1 << 13),
-    SpvGenOptionHlslEnable16BitTypes = (1 << 14)
+    SpvGenOptionHlslEnable16BitTypes = (1 << 14),
+    SpvGenOptionRetainShaders        = (1 << 15),   // Keep stage sources for spvRecompileProgramStage
+    SpvGenOptionDeferLog             = (1 << 16)    // Return an empty log, format it on spvGetProgramLog
 };
 
 enum SpvSourceLanguage : uint32_t
@@ -114,6 +116,273 @@ enum SpvGenStage : uint32_t
     SpvGenNativeStageCount = SpvGenStageCompute + 1,
 };
 
+// Describes one program compiled by spvCompileBatch, the members match the parameters of spvCompileAndLinkProgramEx
+struct SpvCompileBatchItem
+{
+    int                 stageCount;
+    const SpvGenStage*  stageList;
+    const int*          sourceStringCount;
+    const char* const** sourceList;
+    const char* const** fileList;           // Optional, may be null
+    const char**        entryPoints;        // Optional, may be null
+    int                 options;
+};
+
+// Called by spvCompileBatch from a worker thread each time a program is finished
+typedef void (SPVAPI* SpvCompileBatchCallback)(
+    void*       pUserData,
+    int         index,
+    bool        success,
+    void*       hProgram,
+    const char* pLog);
+
+// Called by an asynchronous compile from a worker thread once it is finished. The ticket is already finished when it is
+// called, so it may wait for or destroy the ticket, and a thread waiting for the ticket may resume before it returns.
+typedef void (SPVAPI* SpvCompileAsyncCallback)(
+    void*       pUserData,
+    bool        success,
+    void*       hProgram,
+    const char* pLog);
+
+// One macro definition of a permutation compiled by spvCompilePermutations
+struct SpvMacroDefinition
+{
+    const char* pName;
+    const char* pValue;     // Optional, may be null to define the macro without a value
+};
+
+// Describes one permutation compiled by spvCompilePermutations
+struct SpvPermutation
+{
+    int                       macroCount;
+    const SpvMacroDefinition* pMacros;
+};
+
+// Called by spvDisassembleSpirvStream with each piece of the disassembly text, in order. The text isn't null
+// terminated and is only valid during the call. Returns false to stop the disassembly.
+typedef bool (SPVAPI* SpvTextOutputCallback)(
+    void*        pUserData,
+    const char*  pText,
+    unsigned int length);
+
+// Describes one module of spvAssembleSpirvBatch, spvDisassembleSpirvBatch or spvValidateSpirvBatch
+struct SpvToolsBatchItem
+{
+    const void*  pInput;        // SPIR-V text to assemble, or SPIR-V binary to disassemble or validate
+    size_t       inputSize;     // Size of the input in bytes
+    char*        pLog;          // Optional, receives the diagnostic of a failure, may be null if logSize is 0
+    unsigned int logSize;
+    void*        pOutput;       // [out] Binary or text, must be released like the buffers of the WithAllocator calls
+    unsigned int outputSize;    // [out] Size of the output in bytes
+    bool         success;       // [out]
+};
+
+enum SpvFingerprintFlags : uint32_t
+{
+    SpvFingerprintIgnoreDebugInfo = (1 << 0),   // Drop debug instructions and non-semantic extended instructions
+};
+
+// Canonical 128-bit fingerprint of a SPIR-V module, see spvFingerprintSpirv. The order of independent declarations
+// doesn't change it. Declarations which neither their content, their annotations nor their first use in a function
+// tell apart keep their original order.
+struct SpvFingerprint
+{
+    uint64_t low;
+    uint64_t high;
+};
+
+// One output of spvCrossSpirvTargetsFromParsed
+struct SpvCrossTarget
+{
+    SpvSourceLanguage sourceLanguage;
+    uint32_t          version;          // Version of the shader language, see spvCrossSpirvEx, 0 for the default
+    char*             pLog;             // Optional, receives the error of a failure, may be null if logSize is 0
+    unsigned int      logSize;
+    char*             pSourceString;    // [out] Converted source
+    bool              success;          // [out]
+};
+
+// Describes one module of spvCrossSpirvBatch
+struct SpvCrossBatchItem
+{
+    const void*       pSpvToken;
+    unsigned int      size;             // Size of the binary in bytes
+    SpvSourceLanguage sourceLanguage;
+    uint32_t          version;          // Version of the shader language, see spvCrossSpirvEx, 0 for the default
+    char*             pLog;             // Optional, receives the error of a failure, may be null if logSize is 0
+    unsigned int      logSize;
+    char*             pSourceString;    // [out] Converted source
+    bool              success;          // [out]
+};
+
+// Type of a descriptor reported by spvReflectSpirv, the values match VkDescriptorType
+enum SpvReflectDescriptorType : uint32_t
+{
+    SpvReflectDescriptorSampler               = 0,
+    SpvReflectDescriptorCombinedImageSampler  = 1,
+    SpvReflectDescriptorSampledImage          = 2,
+    SpvReflectDescriptorStorageImage          = 3,
+    SpvReflectDescriptorUniformTexelBuffer    = 4,
+    SpvReflectDescriptorStorageTexelBuffer    = 5,
+    SpvReflectDescriptorUniformBuffer         = 6,
+    SpvReflectDescriptorStorageBuffer         = 7,
+    SpvReflectDescriptorInputAttachment       = 10,
+    SpvReflectDescriptorAccelerationStructure = 1000150000,
+};
+
+// Scalar type of an input or a specialization constant reported by spvReflectSpirv
+enum SpvReflectBaseType : uint32_t
+{
+    SpvReflectBaseTypeUnknown,
+    SpvReflectBaseTypeBool,
+    SpvReflectBaseTypeInt,
+    SpvReflectBaseTypeUint,
+    SpvReflectBaseTypeFloat,
+};
+
+// Spec ID of a workgroup size dimension which isn't a specialization constant
+static const uint32_t SpvReflectNoSpecId = ~0u;
+
+// Descriptor set binding reported by spvReflectSpirv
+struct SpvReflectDescriptor
+{
+    uint32_t                 id;                // Result ID of the variable
+    uint32_t                 set;
+    uint32_t                 binding;
+    SpvReflectDescriptorType descriptorType;
+    uint32_t                 count;             // Number of array elements, 1 if not an array, 0 for a runtime array
+};
+
+// Push constant block reported by spvReflectSpirv
+struct SpvReflectPushConstant
+{
+    uint32_t id;        // Result ID of the variable
+    uint32_t offset;    // Offset of the first member
+    uint32_t size;      // Size from the first member to the end of the last member
+};
+
+// Stage input with a location reported by spvReflectSpirv, the vertex inputs of a vertex shader
+struct SpvReflectInput
+{
+    uint32_t           id;              // Result ID of the variable
+    uint32_t           location;
+    uint32_t           component;
+    SpvReflectBaseType baseType;
+    uint32_t           bitWidth;
+    uint32_t           vectorSize;      // Number of components of a vector, 1 for a scalar
+    uint32_t           columnCount;     // Number of columns of a matrix, 1 otherwise
+    uint32_t           arraySize;       // Number of array elements, 1 if not an array
+};
+
+// Specialization constant reported by spvReflectSpirv
+struct SpvReflectSpecConstant
+{
+    uint32_t           id;              // Result ID of the constant
+    uint32_t           specId;
+    SpvReflectBaseType baseType;
+    uint32_t           bitWidth;
+    uint64_t           defaultValue;    // Bits of the default value, 1 or 0 for a boolean
+};
+
+// Resources of a SPIR-V module reported by spvReflectSpirv. The arrays are stored in the same buffer as the structure.
+struct SpvReflection
+{
+    uint32_t                      workgroupSize[3];         // 0 if no entry-point declares a workgroup size
+    uint32_t                      workgroupSizeSpecIds[3];  // Spec ID of each dimension, or SpvReflectNoSpecId
+    uint32_t                      descriptorCount;
+    const SpvReflectDescriptor*   pDescriptors;
+    uint32_t                      pushConstantCount;
+    const SpvReflectPushConstant* pPushConstants;
+    uint32_t                      inputCount;
+    const SpvReflectInput*        pInputs;
+    uint32_t                      specConstantCount;
+    const SpvReflectSpecConstant* pSpecConstants;
+};
+
+// Statistics of the compile caches
+struct SpvCompileCacheStats
+{
+    uint64_t hitCount;          // In-memory cache
+    uint64_t missCount;
+    uint64_t evictionCount;
+    uint64_t entryCount;
+    uint64_t diskHitCount;      // Persistent cache
+    uint64_t diskMissCount;
+};
+
+// Per-phase timing and size statistics of one stage of a compile, times are in nanoseconds
+struct SpvCompileStageStats
+{
+    uint64_t parseTime;             // TShader::parse()
+    uint64_t linkTime;              // TProgram::link() of the link group of the stage
+    uint64_t mapIoTime;             // TProgram::mapIO() of the link group of the stage
+    uint64_t spirvGenTime;          // GlslangToSpv(), the optimizer included unless it is timed on its own
+    uint64_t optimizeTime;          // Built-in SPIR-V optimizer of glslang, 0 if it didn't run on its own
+    uint64_t sourceSize;            // Size of the source strings in bytes, include files excluded
+    uint32_t includeCount;          // Number of resolved #include directives
+    uint32_t spirvWordCount;        // Size of the SPIR-V binary before an optimization which runs on its own
+    uint32_t optimizedWordCount;    // Size of the SPIR-V binary after optimization
+    bool     cached;                // The program comes from a compile cache, only the word counts are valid
+};
+
+enum SpvDiagnosticSeverity : uint32_t
+{
+    SpvDiagnosticSeverityError,
+    SpvDiagnosticSeverityWarning,
+    SpvDiagnosticSeverityInfo,
+};
+
+// One message of the compile and link log of a program
+struct SpvDiagnostic
+{
+    SpvDiagnosticSeverity severity;
+    SpvGenStage           stage;        // SpvGenStageInvalid if the message doesn't belong to a stage
+    const char*           pFile;        // Source string name or index, empty if unknown
+    uint32_t              line;         // 0 if unknown
+    uint32_t              column;       // 0 if unknown
+    const char*           pMessage;
+};
+
+// Memory statistics of one spvCompileAndLinkProgram*, spvOptimizeSpirv* or spvCrossSpirv* call
+struct SpvMemoryStats
+{
+    uint64_t peakBytes;             // Peak of the memory allocated by the call at the same time
+    uint64_t totalBytes;            // Sum of all allocations of the call
+    bool     budgetExceeded;        // The call failed because it exceeded the memory budget
+    bool     heapTracked;           // The allocations of glslang, SPIRV-Tools and SPIRV-Cross are included, this is
+                                    // only supported by the shared library, otherwise only output buffers are counted
+    bool     valid;                 // The calling thread made a tracked call
+};
+
+// Allocates an output buffer, returns null on failure
+typedef void* (SPVAPI* SpvAllocationFunction)(
+    void*  pUserData,
+    size_t size,
+    size_t alignment);
+
+// Frees an output buffer returned by SpvAllocationFunction
+typedef void (SPVAPI* SpvFreeFunction)(
+    void*  pUserData,
+    void*  pMemory);
+
+// Allocator for the output buffers of spvOptimizeSpirv and spvCrossSpirv
+struct SpvAllocationCallbacks
+{
+    void*                  pUserData;
+    SpvAllocationFunction  pfnAllocation;
+    SpvFreeFunction        pfnFree;
+};
+
+// Parameters of a compiler context created by spvCreateContext
+struct SpvContextCreateInfo
+{
+    const char*  pConfig;            // Resource limits in the format of a .conf file, null for the default limits
+    int          defaultOptions;     // Options of the entry-points without an options parameter
+    unsigned int compileCacheSize;   // Maximum entry count of the in-memory compile cache, 0 disables it
+    const char*  pDiskCacheDir;      // Directory of the persistent compile cache, null disables it
+    uint64_t     diskCacheSize;      // Maximum size of the persistent compile cache in bytes
+};
+
 #ifdef SH_EXPORTING
 
 #ifdef __cplusplus
@@ -150,6 +419,68 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEx(
     const char**       ppLog,
     int                options);
 
+bool SH_IMPORT_EXPORT spvRecompileProgramStage(
+    void*              hProgram,
+    int                stageIndex,
+    int                sourceStringCount,
+    const char* const* sourceList,
+    const char* const* fileList,
+    const char*        entryPoint,
+    const char**       ppLog);
+
+bool SH_IMPORT_EXPORT spvCompileBatch(
+    int                        itemCount,
+    const SpvCompileBatchItem* pItems,
+    void**                     pPrograms,
+    const char**               ppLogs,
+    bool*                      pResults,
+    SpvCompileBatchCallback    pfnCallback,
+    void*                      pUserData);
+
+void* SH_IMPORT_EXPORT spvCompileAndLinkProgramAsync(
+    int                     stageCount,
+    const SpvGenStage*      stageList,
+    const int*              sourceStringCount,
+    const char* const*      sourceList[],
+    const char* const*      fileList[],
+    const char*             entryPoints[],
+    int                     options,
+    SpvCompileAsyncCallback pfnCallback,
+    void*                   pUserData);
+
+bool SH_IMPORT_EXPORT spvWaitCompileTicket(
+    void*        hTicket,
+    unsigned int timeoutMs);
+
+bool SH_IMPORT_EXPORT spvGetCompileTicketResult(
+    void*        hTicket,
+    void**       pProgram,
+    const char** ppLog);
+
+void SH_IMPORT_EXPORT spvDestroyCompileTicket(
+    void* hTicket);
+
+bool SH_IMPORT_EXPORT spvSetThreadCount(
+    unsigned int threadCount);
+
+void SH_IMPORT_EXPORT spvWarmup(
+    int                stageCount,
+    const SpvGenStage* stageList,
+    int                versionCount,
+    const int*         versions,
+    int                options,
+    bool               waitIdle);
+
+void SH_IMPORT_EXPORT spvSetCompileCacheSize(
+    unsigned int maxEntryCount);
+
+bool SH_IMPORT_EXPORT spvSetCompileDiskCache(
+    const char* pCacheDir,
+    uint64_t    maxSize);
+
+bool SH_IMPORT_EXPORT spvGetCompileCacheStats(
+    SpvCompileCacheStats* pStats);
+
 void SH_IMPORT_EXPORT spvDestroyProgram(
     void* hProgram);
 
@@ -174,6 +505,21 @@ bool SH_IMPORT_EXPORT spvDisassembleSpirv(
     unsigned int bufSize,
     char*        pBuffer);
 
+bool SH_IMPORT_EXPORT spvDisassembleSpirvStream(
+    unsigned int          size,
+    const void*           pSpvToken,
+    SpvTextOutputCallback pfnOutput,
+    void*                 pUserData,
+    unsigned int          logSize,
+    char*                 pLog);
+
+// The size is measured by disassembling the module piece by piece, so the query costs as much as a streamed
+// disassembly: up to about twice a single disassembly of the module, since each group of functions repeats the global
+// part. Callers which disassemble right after the query should stream the text instead.
+unsigned int SH_IMPORT_EXPORT spvGetSpirvDisassemblySize(
+    unsigned int size,
+    const void*  pSpvToken);
+
 bool SH_IMPORT_EXPORT spvCrossSpirv(
     SpvSourceLanguage   sourceLanguage,
     unsigned int        size,
@@ -193,6 +539,34 @@ bool SH_IMPORT_EXPORT spvValidateSpirv(
     unsigned int logSize,
     char*        pLog);
 
+uint64_t SH_IMPORT_EXPORT spvGetSpirvToolsContextCount();
+
+bool SH_IMPORT_EXPORT spvAssembleSpirvBatch(
+    int                           itemCount,
+    SpvToolsBatchItem*            pItems,
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvDisassembleSpirvBatch(
+    int                           itemCount,
+    SpvToolsBatchItem*            pItems,
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvValidateSpirvBatch(
+    int                itemCount,
+    SpvToolsBatchItem* pItems);
+
+bool SH_IMPORT_EXPORT spvFingerprintSpirv(
+    unsigned int    size,
+    const void*     pSpvToken,
+    int             flags,
+    SpvFingerprint* pFingerprint);
+
+bool SH_IMPORT_EXPORT spvReflectSpirv(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    SpvReflection**               ppReflection,
+    const SpvAllocationCallbacks* pAllocator);
+
 bool SH_IMPORT_EXPORT spvOptimizeSpirv(
     unsigned int   size,
     const void*    pSpvToken,
@@ -206,6 +580,174 @@ bool SH_IMPORT_EXPORT spvOptimizeSpirv(
 void SH_IMPORT_EXPORT spvFreeBuffer(
     void* pBuffer);
 
+void SH_IMPORT_EXPORT spvSetAllocationCallbacks(
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvCrossSpirvWithAllocator(
+    SpvSourceLanguage             sourceLanguage,
+    uint32_t                      version,
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    char**                        spvCrossSpirv,
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvCrossParseSpirv(
+    unsigned int size,
+    const void*  pSpvToken,
+    void**       phParsedSpirv);
+
+bool SH_IMPORT_EXPORT spvCrossSpirvFromParsed(
+    void*                         hParsedSpirv,
+    SpvSourceLanguage             sourceLanguage,
+    uint32_t                      version,
+    char**                        ppSourceString,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvCrossSpirvTargetsFromParsed(
+    void*                         hParsedSpirv,
+    int                           targetCount,
+    SpvCrossTarget*               pTargets,
+    const SpvAllocationCallbacks* pAllocator);
+
+void SH_IMPORT_EXPORT spvCrossDestroyParsedSpirv(
+    void* hParsedSpirv);
+
+bool SH_IMPORT_EXPORT spvCrossSpirvBatch(
+    int                           itemCount,
+    SpvCrossBatchItem*            pItems,
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvOptimizeSpirvWithAllocator(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    int                           optionCount,
+    const char*                   options[],
+    unsigned int*                 pBufSize,
+    void**                        ppOptBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvAssembleSpirvWithAllocator(
+    const char*                   pSpvText,
+    size_t                        textLength,
+    unsigned int*                 pBufSize,
+    void**                        ppBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+bool SH_IMPORT_EXPORT spvAssembleSpirvFromFile(
+    const char*                   pFileName,
+    unsigned int*                 pBufSize,
+    void**                        ppBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+int SH_IMPORT_EXPORT spvDetachSpirvBinaryFromProgram(
+    void*                hProgram,
+    int                  stage,
+    void**               phBinary,
+    const unsigned int** ppData);
+
+void SH_IMPORT_EXPORT spvDestroySpirvBinary(
+    void* hBinary);
+
+bool SH_IMPORT_EXPORT spvCreateContext(
+    const SpvContextCreateInfo* pCreateInfo,
+    void**                      phContext);
+
+void SH_IMPORT_EXPORT spvDestroyContext(
+    void* hContext);
+
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramWithContext(
+    void*              hContext,
+    int                sourceStringCount[SpvGenNativeStageCount],
+    const char* const* sourceList[SpvGenNativeStageCount],
+    void**             pProgram,
+    const char**       ppLog);
+
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramExWithContext(
+    void*              hContext,
+    int                stageCount,
+    const SpvGenStage* stageList,
+    const int*         sourceStringCount,
+    const char* const* sourceList[],
+    const char* const* fileList[],
+    const char*        entryPoints[],
+    void**             pProgram,
+    const char**       ppLog,
+    int                options);
+
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramFromFileExWithContext(
+    void*              hContext,
+    int                fileNum,
+    const char*        fileList[],
+    const char*        entryPoints[],
+    void**             pProgram,
+    const char**       ppLog,
+    int                options);
+
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEntryPointsFromFile(
+    void*              hContext,
+    const char*        pFileName,
+    int                entryPointCount,
+    const SpvGenStage* stageList,
+    const char*        entryPoints[],
+    void**             ppProgram,
+    const char**       ppLog,
+    int                options);
+
+bool SH_IMPORT_EXPORT spvCompilePermutations(
+    void*                      hContext,
+    const SpvCompileBatchItem* pProgram,
+    int                        permutationCount,
+    const SpvPermutation*      pPermutations,
+    void**                     phPermutations);
+
+bool SH_IMPORT_EXPORT spvGetPermutationResult(
+    void*        hPermutations,
+    int          permutation,
+    int*         pUniqueIndex,
+    const char** ppLog);
+
+int SH_IMPORT_EXPORT spvGetPermutationUniqueCount(
+    void* hPermutations);
+
+int SH_IMPORT_EXPORT spvGetPermutationSpirv(
+    void*                hPermutations,
+    int                  permutation,
+    int                  stage,
+    const unsigned int** ppData);
+
+void SH_IMPORT_EXPORT spvDestroyPermutations(
+    void* hPermutations);
+
+bool SH_IMPORT_EXPORT spvGetCompileCacheStatsWithContext(
+    void*                 hContext,
+    SpvCompileCacheStats* pStats);
+
+bool SH_IMPORT_EXPORT spvGetProgramStats(
+    void*                 hProgram,
+    int                   stage,
+    SpvCompileStageStats* pStats);
+
+void SH_IMPORT_EXPORT spvSetMemoryBudget(
+    uint64_t maxBytes);
+
+bool SH_IMPORT_EXPORT spvGetLastMemoryStats(
+    SpvMemoryStats* pStats);
+
+const char* SH_IMPORT_EXPORT spvGetProgramLog(
+    void* hProgram);
+
+unsigned int SH_IMPORT_EXPORT spvGetProgramDiagnostics(
+    void*                 hProgram,
+    const SpvDiagnostic** ppDiagnostics);
+
 bool SH_IMPORT_EXPORT spvGetVersion(
     SpvGenVersion version,
     unsigned int* pVersion,
@@ -254,6 +796,68 @@ typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvCompileAndLinkProgramEx)(
     const char**       ppLog,
     int                options);
 
+typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvRecompileProgramStage)(
+    void*              hProgram,
+    int                stageIndex,
+    int                sourceStringCount,
+    const char* const* sourceList,
+    const char* const* fileList,
+    const char*        entryPoint,
+    const char**       ppLog);
+
+typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvCompileBatch)(
+    int                        itemCount,
+    const SpvCompileBatchItem* pItems,
+    void**                     pPrograms,
+    const char**               ppLogs,
+    bool*                      pResults,
+    SpvCompileBatchCallback    pfnCallback,
+    void*                      pUserData);
+
+typedef void* SH_IMPORT_EXPORT(SPVAPI* PFN_spvCompileAndLinkProgramAsync)(
+    int                     stageCount,
+    const SpvGenStage*      stageList,
+    const int*              sourceStringCount,
+    const char* const*      sourceList[],
+    const char* const*      fileList[],
+    const char*             entryPoints[],
+    int                     options,
+    SpvCompileAsyncCallback pfnCallback,
+    void*                   pUserData);
+
+typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvWaitCompileTicket)(
+    void*        hTicket,
+    unsigned int timeoutMs);
+
+typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvGetCompileTicketResult)(
+    void*        hTicket,
+    void**       pProgram,
+    const char** ppLog);
+
+typedef void SH_IMPORT_EXPORT(SPVAPI* PFN_spvDestroyCompileTicket)(
+    void* hTicket);
+
+typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvSetThreadCount)(
+    unsigned int threadCount);
+
+typedef void SH_IMPORT_EXPORT(SPVAPI* PFN_spvWarmup)(
+    int                stageCount,
+    const SpvGenStage* stageList,
+    int                versionCount,
+    const int*         versions,
+    int                options,
+    bool               waitIdle);
+
+typedef void SH_IMPORT_EXPORT(SPVAPI* PFN_spvSetCompileCacheSize)(
+    unsigned int maxEntryCount);
+
+typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvSetCompileDiskCache)(
+    const char* pCacheDir,
+    uint64_t    maxSize);
+
+typedef bool SH_IMPORT_EXPORT(SPVAPI* PFN_spvGetCompileCacheStats)(
+    SpvCompileCacheStats* pStats);
+
 typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvDestroyProgram)(void* hProgram);
 
 typedef int SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetSpirvBinaryFromProgram)(
@@ -277,6 +881,18 @@ typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvDisassembleSpirv)(
     unsigned int        textBufSize,
     char*               pSpvTextBuf);
 
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvDisassembleSpirvStream)(
+    unsigned int          size,
+    const void*           pSpvToken,
+    SpvTextOutputCallback pfnOutput,
+    void*                 pUserData,
+    unsigned int          logSize,
+    char*                 pLog);
+
+typedef unsigned int SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetSpirvDisassemblySize)(
+    unsigned int size,
+    const void*  pSpvToken);
+
 typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCrossSpirv)(
     SpvSourceLanguage   sourceLanguage,
     unsigned int        size,
@@ -296,6 +912,34 @@ typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvValidateSpirv)(
     unsigned int        bufSize,
     char*               pLog);
 
+typedef uint64_t SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetSpirvToolsContextCount)();
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvAssembleSpirvBatch)(
+    int                           itemCount,
+    SpvToolsBatchItem*            pItems,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvDisassembleSpirvBatch)(
+    int                           itemCount,
+    SpvToolsBatchItem*            pItems,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvValidateSpirvBatch)(
+    int                itemCount,
+    SpvToolsBatchItem* pItems);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvFingerprintSpirv)(
+    unsigned int    size,
+    const void*     pSpvToken,
+    int             flags,
+    SpvFingerprint* pFingerprint);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvReflectSpirv)(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    SpvReflection**               ppReflection,
+    const SpvAllocationCallbacks* pAllocator);
+
 typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvOptimizeSpirv)(
     unsigned int   size,
     const void*    pSpvToken,
@@ -309,6 +953,174 @@ typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvOptimizeSpirv)(
 typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvFreeBuffer)(
     void* pBuffer);
 
+typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvSetAllocationCallbacks)(
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCrossSpirvWithAllocator)(
+    SpvSourceLanguage             sourceLanguage,
+    uint32_t                      version,
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    char**                        spvCrossSpirv,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCrossParseSpirv)(
+    unsigned int size,
+    const void*  pSpvToken,
+    void**       phParsedSpirv);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCrossSpirvFromParsed)(
+    void*                         hParsedSpirv,
+    SpvSourceLanguage             sourceLanguage,
+    uint32_t                      version,
+    char**                        ppSourceString,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCrossSpirvTargetsFromParsed)(
+    void*                         hParsedSpirv,
+    int                           targetCount,
+    SpvCrossTarget*               pTargets,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvCrossDestroyParsedSpirv)(
+    void* hParsedSpirv);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCrossSpirvBatch)(
+    int                           itemCount,
+    SpvCrossBatchItem*            pItems,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvOptimizeSpirvWithAllocator)(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    int                           optionCount,
+    const char*                   options[],
+    unsigned int*                 pBufSize,
+    void**                        ppOptBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvAssembleSpirvWithAllocator)(
+    const char*                   pSpvText,
+    size_t                        textLength,
+    unsigned int*                 pBufSize,
+    void**                        ppBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvAssembleSpirvFromFile)(
+    const char*                   pFileName,
+    unsigned int*                 pBufSize,
+    void**                        ppBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator);
+
+typedef int SH_IMPORT_EXPORT (SPVAPI* PFN_spvDetachSpirvBinaryFromProgram)(
+    void*                hProgram,
+    int                  stage,
+    void**               phBinary,
+    const unsigned int** ppData);
+
+typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvDestroySpirvBinary)(
+    void* hBinary);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCreateContext)(
+    const SpvContextCreateInfo* pCreateInfo,
+    void**                      phContext);
+
+typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvDestroyContext)(
+    void* hContext);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCompileAndLinkProgramWithContext)(
+    void*              hContext,
+    int                sourceStringCount[SpvGenNativeStageCount],
+    const char* const* sourceList[SpvGenNativeStageCount],
+    void**             pProgram,
+    const char**       ppLog);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCompileAndLinkProgramExWithContext)(
+    void*              hContext,
+    int                stageCount,
+    const SpvGenStage* stageList,
+    const int*         sourceStringCount,
+    const char* const* sourceList[],
+    const char* const* fileList[],
+    const char*        entryPoints[],
+    void**             pProgram,
+    const char**       ppLog,
+    int                options);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCompileAndLinkProgramFromFileExWithContext)(
+    void*              hContext,
+    int                fileNum,
+    const char*        fileList[],
+    const char*        entryPoints[],
+    void**             pProgram,
+    const char**       ppLog,
+    int                options);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCompileAndLinkProgramEntryPointsFromFile)(
+    void*              hContext,
+    const char*        pFileName,
+    int                entryPointCount,
+    const SpvGenStage* stageList,
+    const char*        entryPoints[],
+    void**             ppProgram,
+    const char**       ppLog,
+    int                options);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvCompilePermutations)(
+    void*                      hContext,
+    const SpvCompileBatchItem* pProgram,
+    int                        permutationCount,
+    const SpvPermutation*      pPermutations,
+    void**                     phPermutations);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetPermutationResult)(
+    void*        hPermutations,
+    int          permutation,
+    int*         pUniqueIndex,
+    const char** ppLog);
+
+typedef int SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetPermutationUniqueCount)(
+    void* hPermutations);
+
+typedef int SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetPermutationSpirv)(
+    void*                hPermutations,
+    int                  permutation,
+    int                  stage,
+    const unsigned int** ppData);
+
+typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvDestroyPermutations)(
+    void* hPermutations);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetCompileCacheStatsWithContext)(
+    void*                 hContext,
+    SpvCompileCacheStats* pStats);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetProgramStats)(
+    void*                 hProgram,
+    int                   stage,
+    SpvCompileStageStats* pStats);
+
+typedef void SH_IMPORT_EXPORT (SPVAPI* PFN_spvSetMemoryBudget)(
+    uint64_t maxBytes);
+
+typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetLastMemoryStats)(
+    SpvMemoryStats* pStats);
+
+typedef const char* SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetProgramLog)(
+    void* hProgram);
+
+typedef unsigned int SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetProgramDiagnostics)(
+    void*                 hProgram,
+    const SpvDiagnostic** ppDiagnostics);
+
 typedef bool SH_IMPORT_EXPORT (SPVAPI* PFN_spvGetVersion)(
     SpvGenVersion  version,
      unsigned int* pVersion,
@@ -334,6 +1146,54 @@ DECL_EXPORT_FUNC(spvValidateSpirv);
 DECL_EXPORT_FUNC(spvOptimizeSpirv);
 DECL_EXPORT_FUNC(spvFreeBuffer);
 DECL_EXPORT_FUNC(spvGetVersion);
+DECL_EXPORT_FUNC(spvCompileBatch);
+DECL_EXPORT_FUNC(spvSetCompileCacheSize);
+DECL_EXPORT_FUNC(spvGetCompileCacheStats);
+DECL_EXPORT_FUNC(spvSetCompileDiskCache);
+DECL_EXPORT_FUNC(spvCompileAndLinkProgramAsync);
+DECL_EXPORT_FUNC(spvWaitCompileTicket);
+DECL_EXPORT_FUNC(spvGetCompileTicketResult);
+DECL_EXPORT_FUNC(spvDestroyCompileTicket);
+DECL_EXPORT_FUNC(spvSetThreadCount);
+DECL_EXPORT_FUNC(spvWarmup);
+DECL_EXPORT_FUNC(spvRecompileProgramStage);
+DECL_EXPORT_FUNC(spvSetAllocationCallbacks);
+DECL_EXPORT_FUNC(spvCrossSpirvWithAllocator);
+DECL_EXPORT_FUNC(spvOptimizeSpirvWithAllocator);
+DECL_EXPORT_FUNC(spvDetachSpirvBinaryFromProgram);
+DECL_EXPORT_FUNC(spvDestroySpirvBinary);
+DECL_EXPORT_FUNC(spvCreateContext);
+DECL_EXPORT_FUNC(spvDestroyContext);
+DECL_EXPORT_FUNC(spvCompileAndLinkProgramWithContext);
+DECL_EXPORT_FUNC(spvCompileAndLinkProgramExWithContext);
+DECL_EXPORT_FUNC(spvCompileAndLinkProgramFromFileExWithContext);
+DECL_EXPORT_FUNC(spvGetCompileCacheStatsWithContext);
+DECL_EXPORT_FUNC(spvGetProgramStats);
+DECL_EXPORT_FUNC(spvSetMemoryBudget);
+DECL_EXPORT_FUNC(spvGetLastMemoryStats);
+DECL_EXPORT_FUNC(spvGetProgramLog);
+DECL_EXPORT_FUNC(spvGetProgramDiagnostics);
+DECL_EXPORT_FUNC(spvCompileAndLinkProgramEntryPointsFromFile);
+DECL_EXPORT_FUNC(spvCompilePermutations);
+DECL_EXPORT_FUNC(spvGetPermutationResult);
+DECL_EXPORT_FUNC(spvGetPermutationUniqueCount);
+DECL_EXPORT_FUNC(spvGetPermutationSpirv);
+DECL_EXPORT_FUNC(spvDestroyPermutations);
+DECL_EXPORT_FUNC(spvGetSpirvToolsContextCount);
+DECL_EXPORT_FUNC(spvDisassembleSpirvStream);
+DECL_EXPORT_FUNC(spvGetSpirvDisassemblySize);
+DECL_EXPORT_FUNC(spvAssembleSpirvWithAllocator);
+DECL_EXPORT_FUNC(spvAssembleSpirvFromFile);
+DECL_EXPORT_FUNC(spvAssembleSpirvBatch);
+DECL_EXPORT_FUNC(spvDisassembleSpirvBatch);
+DECL_EXPORT_FUNC(spvValidateSpirvBatch);
+DECL_EXPORT_FUNC(spvFingerprintSpirv);
+DECL_EXPORT_FUNC(spvCrossParseSpirv);
+DECL_EXPORT_FUNC(spvCrossSpirvFromParsed);
+DECL_EXPORT_FUNC(spvCrossSpirvTargetsFromParsed);
+DECL_EXPORT_FUNC(spvCrossDestroyParsedSpirv);
+DECL_EXPORT_FUNC(spvReflectSpirv);
+DECL_EXPORT_FUNC(spvCrossSpirvBatch);
 
 bool SPVAPI InitSpvGen(const char* pSpvGenDir = nullptr);
 
@@ -361,6 +1221,54 @@ DEFI_EXPORT_FUNC(spvValidateSpirv);
 DEFI_EXPORT_FUNC(spvOptimizeSpirv);
 DEFI_EXPORT_FUNC(spvFreeBuffer);
 DEFI_EXPORT_FUNC(spvGetVersion);
+DEFI_EXPORT_FUNC(spvCompileBatch);
+DEFI_EXPORT_FUNC(spvSetCompileCacheSize);
+DEFI_EXPORT_FUNC(spvGetCompileCacheStats);
+DEFI_EXPORT_FUNC(spvSetCompileDiskCache);
+DEFI_EXPORT_FUNC(spvCompileAndLinkProgramAsync);
+DEFI_EXPORT_FUNC(spvWaitCompileTicket);
+DEFI_EXPORT_FUNC(spvGetCompileTicketResult);
+DEFI_EXPORT_FUNC(spvDestroyCompileTicket);
+DEFI_EXPORT_FUNC(spvSetThreadCount);
+DEFI_EXPORT_FUNC(spvWarmup);
+DEFI_EXPORT_FUNC(spvRecompileProgramStage);
+DEFI_EXPORT_FUNC(spvSetAllocationCallbacks);
+DEFI_EXPORT_FUNC(spvCrossSpirvWithAllocator);
+DEFI_EXPORT_FUNC(spvOptimizeSpirvWithAllocator);
+DEFI_EXPORT_FUNC(spvDetachSpirvBinaryFromProgram);
+DEFI_EXPORT_FUNC(spvDestroySpirvBinary);
+DEFI_EXPORT_FUNC(spvCreateContext);
+DEFI_EXPORT_FUNC(spvDestroyContext);
+DEFI_EXPORT_FUNC(spvCompileAndLinkProgramWithContext);
+DEFI_EXPORT_FUNC(spvCompileAndLinkProgramExWithContext);
+DEFI_EXPORT_FUNC(spvCompileAndLinkProgramFromFileExWithContext);
+DEFI_EXPORT_FUNC(spvGetCompileCacheStatsWithContext);
+DEFI_EXPORT_FUNC(spvGetProgramStats);
+DEFI_EXPORT_FUNC(spvSetMemoryBudget);
+DEFI_EXPORT_FUNC(spvGetLastMemoryStats);
+DEFI_EXPORT_FUNC(spvGetProgramLog);
+DEFI_EXPORT_FUNC(spvGetProgramDiagnostics);
+DEFI_EXPORT_FUNC(spvCompileAndLinkProgramEntryPointsFromFile);
+DEFI_EXPORT_FUNC(spvCompilePermutations);
+DEFI_EXPORT_FUNC(spvGetPermutationResult);
+DEFI_EXPORT_FUNC(spvGetPermutationUniqueCount);
+DEFI_EXPORT_FUNC(spvGetPermutationSpirv);
+DEFI_EXPORT_FUNC(spvDestroyPermutations);
+DEFI_EXPORT_FUNC(spvGetSpirvToolsContextCount);
+DEFI_EXPORT_FUNC(spvDisassembleSpirvStream);
+DEFI_EXPORT_FUNC(spvGetSpirvDisassemblySize);
+DEFI_EXPORT_FUNC(spvAssembleSpirvWithAllocator);
+DEFI_EXPORT_FUNC(spvAssembleSpirvFromFile);
+DEFI_EXPORT_FUNC(spvAssembleSpirvBatch);
+DEFI_EXPORT_FUNC(spvDisassembleSpirvBatch);
+DEFI_EXPORT_FUNC(spvValidateSpirvBatch);
+DEFI_EXPORT_FUNC(spvFingerprintSpirv);
+DEFI_EXPORT_FUNC(spvCrossParseSpirv);
+DEFI_EXPORT_FUNC(spvCrossSpirvFromParsed);
+DEFI_EXPORT_FUNC(spvCrossSpirvTargetsFromParsed);
+DEFI_EXPORT_FUNC(spvCrossDestroyParsedSpirv);
+DEFI_EXPORT_FUNC(spvReflectSpirv);
+DEFI_EXPORT_FUNC(spvCrossSpirvBatch);
 
 // SPIR-V generator Windows implementation
 #if defined(_WIN32)
@@ -448,6 +1356,56 @@ bool SPVAPI InitSpvGen(
         INITFUNC(spvOptimizeSpirv);
         INITFUNC(spvFreeBuffer);
         INITFUNC(spvGetVersion);
+
+        // Optional entry-points, they are absent in older SPVGEN libraries
+        INIT_OPT_FUNC(spvCompileBatch);
+        INIT_OPT_FUNC(spvSetCompileCacheSize);
+        INIT_OPT_FUNC(spvGetCompileCacheStats);
+        INIT_OPT_FUNC(spvSetCompileDiskCache);
+        INIT_OPT_FUNC(spvCompileAndLinkProgramAsync);
+        INIT_OPT_FUNC(spvWaitCompileTicket);
+        INIT_OPT_FUNC(spvGetCompileTicketResult);
+        INIT_OPT_FUNC(spvDestroyCompileTicket);
+        INIT_OPT_FUNC(spvSetThreadCount);
+        INIT_OPT_FUNC(spvWarmup);
+        INIT_OPT_FUNC(spvRecompileProgramStage);
+        INIT_OPT_FUNC(spvSetAllocationCallbacks);
+        INIT_OPT_FUNC(spvCrossSpirvWithAllocator);
+        INIT_OPT_FUNC(spvOptimizeSpirvWithAllocator);
+        INIT_OPT_FUNC(spvDetachSpirvBinaryFromProgram);
+        INIT_OPT_FUNC(spvDestroySpirvBinary);
+        INIT_OPT_FUNC(spvCreateContext);
+        INIT_OPT_FUNC(spvDestroyContext);
+        INIT_OPT_FUNC(spvCompileAndLinkProgramWithContext);
+        INIT_OPT_FUNC(spvCompileAndLinkProgramExWithContext);
+        INIT_OPT_FUNC(spvCompileAndLinkProgramFromFileExWithContext);
+        INIT_OPT_FUNC(spvGetCompileCacheStatsWithContext);
+        INIT_OPT_FUNC(spvGetProgramStats);
+        INIT_OPT_FUNC(spvSetMemoryBudget);
+        INIT_OPT_FUNC(spvGetLastMemoryStats);
+        INIT_OPT_FUNC(spvGetProgramLog);
+        INIT_OPT_FUNC(spvGetProgramDiagnostics);
+        INIT_OPT_FUNC(spvCompileAndLinkProgramEntryPointsFromFile);
+        INIT_OPT_FUNC(spvCompilePermutations);
+        INIT_OPT_FUNC(spvGetPermutationResult);
+        INIT_OPT_FUNC(spvGetPermutationUniqueCount);
+        INIT_OPT_FUNC(spvGetPermutationSpirv);
+        INIT_OPT_FUNC(spvDestroyPermutations);
+        INIT_OPT_FUNC(spvGetSpirvToolsContextCount);
+        INIT_OPT_FUNC(spvDisassembleSpirvStream);
+        INIT_OPT_FUNC(spvGetSpirvDisassemblySize);
+        INIT_OPT_FUNC(spvAssembleSpirvWithAllocator);
+        INIT_OPT_FUNC(spvAssembleSpirvFromFile);
+        INIT_OPT_FUNC(spvAssembleSpirvBatch);
+        INIT_OPT_FUNC(spvDisassembleSpirvBatch);
+        INIT_OPT_FUNC(spvValidateSpirvBatch);
+        INIT_OPT_FUNC(spvFingerprintSpirv);
+        INIT_OPT_FUNC(spvCrossParseSpirv);
+        INIT_OPT_FUNC(spvCrossSpirvFromParsed);
+        INIT_OPT_FUNC(spvCrossSpirvTargetsFromParsed);
+        INIT_OPT_FUNC(spvCrossDestroyParsedSpirv);
+        INIT_OPT_FUNC(spvReflectSpirv);
+        INIT_OPT_FUNC(spvCrossSpirvBatch);
     }
     else
     {
@@ -482,6 +1440,54 @@ bool SPVAPI InitSpvGen(
         DEINITFUNC(spvOptimizeSpirv);
         DEINITFUNC(spvFreeBuffer);
         DEINITFUNC(spvGetVersion);
+        DEINITFUNC(spvCompileBatch);
+        DEINITFUNC(spvSetCompileCacheSize);
+        DEINITFUNC(spvGetCompileCacheStats);
+        DEINITFUNC(spvSetCompileDiskCache);
+        DEINITFUNC(spvCompileAndLinkProgramAsync);
+        DEINITFUNC(spvWaitCompileTicket);
+        DEINITFUNC(spvGetCompileTicketResult);
+        DEINITFUNC(spvDestroyCompileTicket);
+        DEINITFUNC(spvSetThreadCount);
+        DEINITFUNC(spvWarmup);
+        DEINITFUNC(spvRecompileProgramStage);
+        DEINITFUNC(spvSetAllocationCallbacks);
+        DEINITFUNC(spvCrossSpirvWithAllocator);
+        DEINITFUNC(spvOptimizeSpirvWithAllocator);
+        DEINITFUNC(spvDetachSpirvBinaryFromProgram);
+        DEINITFUNC(spvDestroySpirvBinary);
+        DEINITFUNC(spvCreateContext);
+        DEINITFUNC(spvDestroyContext);
+        DEINITFUNC(spvCompileAndLinkProgramWithContext);
+        DEINITFUNC(spvCompileAndLinkProgramExWithContext);
+        DEINITFUNC(spvCompileAndLinkProgramFromFileExWithContext);
+        DEINITFUNC(spvGetCompileCacheStatsWithContext);
+        DEINITFUNC(spvGetProgramStats);
+        DEINITFUNC(spvSetMemoryBudget);
+        DEINITFUNC(spvGetLastMemoryStats);
+        DEINITFUNC(spvGetProgramLog);
+        DEINITFUNC(spvGetProgramDiagnostics);
+        DEINITFUNC(spvCompileAndLinkProgramEntryPointsFromFile);
+        DEINITFUNC(spvCompilePermutations);
+        DEINITFUNC(spvGetPermutationResult);
+        DEINITFUNC(spvGetPermutationUniqueCount);
+        DEINITFUNC(spvGetPermutationSpirv);
+        DEINITFUNC(spvDestroyPermutations);
+        DEINITFUNC(spvGetSpirvToolsContextCount);
+        DEINITFUNC(spvDisassembleSpirvStream);
+        DEINITFUNC(spvGetSpirvDisassemblySize);
+        DEINITFUNC(spvAssembleSpirvWithAllocator);
+        DEINITFUNC(spvAssembleSpirvFromFile);
+        DEINITFUNC(spvAssembleSpirvBatch);
+        DEINITFUNC(spvDisassembleSpirvBatch);
+        DEINITFUNC(spvValidateSpirvBatch);
+        DEINITFUNC(spvFingerprintSpirv);
+        DEINITFUNC(spvCrossParseSpirv);
+        DEINITFUNC(spvCrossSpirvFromParsed);
+        DEINITFUNC(spvCrossSpirvTargetsFromParsed);
+        DEINITFUNC(spvCrossDestroyParsedSpirv);
+        DEINITFUNC(spvReflectSpirv);
+        DEINITFUNC(spvCrossSpirvBatch);
     }
     return success;
 }
@@ -509,6 +1515,54 @@ void SPVAPI FinalizeSpvgen() {}
 #define spvOptimizeSpirv                    g_pfnspvOptimizeSpirv
 #define spvFreeBuffer                       g_pfnspvFreeBuffer
 #define spvGetVersion                       g_pfnspvGetVersion
+#define spvCompileBatch                     g_pfnspvCompileBatch
+#define spvSetCompileCacheSize              g_pfnspvSetCompileCacheSize
+#define spvGetCompileCacheStats             g_pfnspvGetCompileCacheStats
+#define spvSetCompileDiskCache              g_pfnspvSetCompileDiskCache
+#define spvCompileAndLinkProgramAsync       g_pfnspvCompileAndLinkProgramAsync
+#define spvWaitCompileTicket                g_pfnspvWaitCompileTicket
+#define spvGetCompileTicketResult           g_pfnspvGetCompileTicketResult
+#define spvDestroyCompileTicket             g_pfnspvDestroyCompileTicket
+#define spvSetThreadCount                   g_pfnspvSetThreadCount
+#define spvWarmup                           g_pfnspvWarmup
+#define spvRecompileProgramStage            g_pfnspvRecompileProgramStage
+#define spvSetAllocationCallbacks           g_pfnspvSetAllocationCallbacks
+#define spvCrossSpirvWithAllocator          g_pfnspvCrossSpirvWithAllocator
+#define spvOptimizeSpirvWithAllocator       g_pfnspvOptimizeSpirvWithAllocator
+#define spvDetachSpirvBinaryFromProgram     g_pfnspvDetachSpirvBinaryFromProgram
+#define spvDestroySpirvBinary               g_pfnspvDestroySpirvBinary
+#define spvCreateContext                    g_pfnspvCreateContext
+#define spvDestroyContext                   g_pfnspvDestroyContext
+#define spvCompileAndLinkProgramWithContext g_pfnspvCompileAndLinkProgramWithContext
+#define spvCompileAndLinkProgramExWithContext g_pfnspvCompileAndLinkProgramExWithContext
+#define spvCompileAndLinkProgramFromFileExWithContext g_pfnspvCompileAndLinkProgramFromFileExWithContext
+#define spvGetCompileCacheStatsWithContext  g_pfnspvGetCompileCacheStatsWithContext
+#define spvGetProgramStats                  g_pfnspvGetProgramStats
+#define spvSetMemoryBudget                  g_pfnspvSetMemoryBudget
+#define spvGetLastMemoryStats               g_pfnspvGetLastMemoryStats
+#define spvGetProgramLog                    g_pfnspvGetProgramLog
+#define spvGetProgramDiagnostics            g_pfnspvGetProgramDiagnostics
+#define spvCompileAndLinkProgramEntryPointsFromFile g_pfnspvCompileAndLinkProgramEntryPointsFromFile
+#define spvCompilePermutations              g_pfnspvCompilePermutations
+#define spvGetPermutationResult             g_pfnspvGetPermutationResult
+#define spvGetPermutationUniqueCount        g_pfnspvGetPermutationUniqueCount
+#define spvGetPermutationSpirv              g_pfnspvGetPermutationSpirv
+#define spvDestroyPermutations              g_pfnspvDestroyPermutations
+#define spvGetSpirvToolsContextCount        g_pfnspvGetSpirvToolsContextCount
+#define spvDisassembleSpirvStream           g_pfnspvDisassembleSpirvStream
+#define spvGetSpirvDisassemblySize          g_pfnspvGetSpirvDisassemblySize
+#define spvAssembleSpirvWithAllocator       g_pfnspvAssembleSpirvWithAllocator
+#define spvAssembleSpirvFromFile            g_pfnspvAssembleSpirvFromFile
+#define spvAssembleSpirvBatch               g_pfnspvAssembleSpirvBatch
+#define spvDisassembleSpirvBatch            g_pfnspvDisassembleSpirvBatch
+#define spvValidateSpirvBatch               g_pfnspvValidateSpirvBatch
+#define spvFingerprintSpirv                 g_pfnspvFingerprintSpirv
+#define spvCrossParseSpirv                  g_pfnspvCrossParseSpirv
+#define spvCrossSpirvFromParsed             g_pfnspvCrossSpirvFromParsed
+#define spvCrossSpirvTargetsFromParsed      g_pfnspvCrossSpirvTargetsFromParsed
+#define spvCrossDestroyParsedSpirv          g_pfnspvCrossDestroyParsedSpirv
+#define spvReflectSpirv                     g_pfnspvReflectSpirv
+#define spvCrossSpirvBatch                  g_pfnspvCrossSpirvBatch
 
 #endif
 
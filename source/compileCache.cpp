@@ -0,0 +1,105 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  compileCache.cpp
+* @brief SPVGEN source file: contains the implementation of the in-memory compile result cache.
+***********************************************************************************************************************
+*/
+#include "compileCache.h"
+
+// =====================================================================================================================
+SpvCompileCache::SpvCompileCache(
+    uint32_t maxEntryCount)     // Maximum number of entries of the whole cache
+    :
+    maxShardEntryCount((maxEntryCount + ShardCount - 1) / ShardCount),
+    hitCount(0),
+    missCount(0),
+    evictionCount(0)
+{
+}
+
+// =====================================================================================================================
+// Find the entry for the specified key, returns null on a miss
+std::shared_ptr<const SpvCompileCacheEntry> SpvCompileCache::Find(
+    const SpvHash128& key)  // Content hash of the compile input
+{
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end())
+    {
+        ++missCount;
+        return nullptr;
+    }
+
+    // Move to the front of the LRU list, this doesn't invalidate the iterator
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    ++hitCount;
+    return it->second->second;
+}
+
+// =====================================================================================================================
+// Add an entry, the least recently used entry of the shard is evicted if it is full
+void SpvCompileCache::Insert(
+    const SpvHash128&                           key,    // Content hash of the compile input
+    std::shared_ptr<const SpvCompileCacheEntry> entry)  // Compile result
+{
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end())
+    {
+        // Another thread compiled the same input concurrently, keep the existing entry
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    while ((shard.lru.empty() == false) && (shard.lru.size() >= maxShardEntryCount))
+    {
+        shard.entries.erase(shard.lru.back().first);
+        shard.lru.pop_back();
+        ++evictionCount;
+    }
+
+    shard.lru.emplace_front(key, std::move(entry));
+    shard.entries[key] = shard.lru.begin();
+}
+
+// =====================================================================================================================
+// Get the number of entries in the cache
+uint64_t SpvCompileCache::GetEntryCount() const
+{
+    uint64_t entryCount = 0;
+    for (uint32_t i = 0; i < ShardCount; ++i)
+    {
+        const Shard& shard = shards[i];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        entryCount += shard.lru.size();
+    }
+    return entryCount;
+}
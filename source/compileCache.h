@@ -0,0 +1,93 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  compileCache.h
+* @brief SPVGEN header file: contains the declaration of the in-memory compile result cache.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include "diagnostics.h"
+#include "hasher.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// =====================================================================================================================
+// Represents a cached result of a successful spvCompileAndLinkProgramEx call
+struct SpvCompileCacheEntry
+{
+    std::vector<std::vector<unsigned int>> spirvs;        // SPIR-V binary of each stage
+    SpvDiagnosticList                      diagnostics;   // Program log of the compile
+};
+
+// =====================================================================================================================
+// Bounded, content-addressed LRU cache of compile results.
+//
+// The cache is split into shards selected by the key, each shard has its own lock and LRU list, so concurrent lookups
+// of different keys rarely contend. Entries are immutable and shared, a lookup never copies SPIR-V under the lock.
+class SpvCompileCache
+{
+public:
+    explicit SpvCompileCache(uint32_t maxEntryCount);
+
+    // Find the entry for the specified key, returns null on a miss
+    std::shared_ptr<const SpvCompileCacheEntry> Find(const SpvHash128& key);
+
+    // Add an entry, the least recently used entry of the shard is evicted if it is full
+    void Insert(const SpvHash128& key, std::shared_ptr<const SpvCompileCacheEntry> entry);
+
+    uint64_t GetHitCount() const { return hitCount; }
+    uint64_t GetMissCount() const { return missCount; }
+    uint64_t GetEvictionCount() const { return evictionCount; }
+    uint64_t GetEntryCount() const;
+
+private:
+    static const uint32_t ShardCount = 16;
+
+    typedef std::pair<SpvHash128, std::shared_ptr<const SpvCompileCacheEntry>> LruItem;
+
+    // One independently locked part of the cache
+    struct Shard
+    {
+        mutable std::mutex                                                           lock;
+        std::list<LruItem>                                                           lru;     // Most recent first
+        std::unordered_map<SpvHash128, std::list<LruItem>::iterator, SpvHash128Hasher> entries;
+    };
+
+    Shard& GetShard(const SpvHash128& key) { return shards[key.hi % ShardCount]; }
+
+    Shard                  shards[ShardCount];
+    uint32_t               maxShardEntryCount;
+    std::atomic<uint64_t>  hitCount;
+    std::atomic<uint64_t>  missCount;
+    std::atomic<uint64_t>  evictionCount;
+};
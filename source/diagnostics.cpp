@@ -0,0 +1,447 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  diagnostics.cpp
+* @brief SPVGEN source file: contains the implementation of the structured diagnostics of program logs.
+***********************************************************************************************************************
+*/
+#include "diagnostics.h"
+
+#include "glslang/Public/ShaderLang.h"
+
+#include <cstdio>
+#include <cstring>
+
+EShLanguage SpvGenStageToEShLanguage(SpvGenStage stage);
+
+// Severity prefixes of glslang and spvgen messages
+static const struct
+{
+    const char*           pPrefix;
+    SpvDiagnosticSeverity severity;
+} SeverityPrefixes[] =
+{
+    { "ERROR: ",          SpvDiagnosticSeverityError },
+    { "INTERNAL ERROR: ", SpvDiagnosticSeverityError },
+    { "UNIMPLEMENTED: ",  SpvDiagnosticSeverityError },
+    { "error: ",          SpvDiagnosticSeverityError },
+    { "WARNING: ",        SpvDiagnosticSeverityWarning },
+    { "warning: ",        SpvDiagnosticSeverityWarning },
+    { "NOTE: ",           SpvDiagnosticSeverityInfo },
+};
+
+// =====================================================================================================================
+// Parse an unsigned decimal number which spans the whole string, returns false if it isn't one
+static bool ParseNumber(
+    const std::string& text,      // [in] Text to parse
+    uint32_t*          pNumber)   // [out] Parsed number
+{
+    if (text.empty() || (text.size() > 9))
+    {
+        return false;
+    }
+
+    uint32_t number = 0;
+    for (char c : text)
+    {
+        if ((c < '0') || (c > '9'))
+        {
+            return false;
+        }
+        number = number * 10 + static_cast<uint32_t>(c - '0');
+    }
+    *pNumber = number;
+    return true;
+}
+
+// =====================================================================================================================
+// Split a source location "<file>:<line>" or "<file>:<line>:<column>", returns false if the text isn't a location
+static bool ParseLocation(
+    const std::string& text,       // [in] Text in front of the message
+    std::string*       pFile,      // [out] Source string name or index
+    uint32_t*          pLine,      // [out] Line number
+    uint32_t*          pColumn)    // [out] Column number, 0 if the location has none
+{
+    size_t separator = text.rfind(':');
+    uint32_t last = 0;
+    if ((separator == std::string::npos) ||
+        (separator == 0) ||
+        (ParseNumber(text.substr(separator + 1), &last) == false))
+    {
+        return false;
+    }
+
+    std::string head = text.substr(0, separator);
+    separator = head.rfind(':');
+    uint32_t line = 0;
+    if ((separator != std::string::npos) && (separator != 0) && ParseNumber(head.substr(separator + 1), &line))
+    {
+        *pFile = head.substr(0, separator);
+        *pLine = line;
+        *pColumn = last;
+    }
+    else
+    {
+        *pFile = head;
+        *pLine = last;
+        *pColumn = 0;
+    }
+    return true;
+}
+
+// =====================================================================================================================
+// Get the stage of a "Compiling <stage> stage:", "Linking <stage> stage:" or "Linked <stage> stage:" header line,
+// returns false if the line isn't a header
+static bool ParseStageHeader(
+    const std::string&        line,     // [in] Log line
+    SpvDiagnosticList::Phase* pPhase,   // [out] Compile step of the header
+    SpvGenStage*              pStage)   // [out] Stage of the header
+{
+    static const struct
+    {
+        const char*              pVerb;
+        SpvDiagnosticList::Phase phase;
+    } Verbs[] =
+    {
+        { "Compiling ", SpvDiagnosticList::PhaseCompile },
+        { "Linking ",   SpvDiagnosticList::PhaseLink },
+        { "Linked ",    SpvDiagnosticList::PhaseLink },
+    };
+    static const char Suffix[] = " stage:";
+    const size_t suffixLength = sizeof(Suffix) - 1;
+
+    for (const auto& verb : Verbs)
+    {
+        const size_t verbLength = strlen(verb.pVerb);
+        if ((line.size() > verbLength + suffixLength) &&
+            (line.compare(0, verbLength, verb.pVerb) == 0) &&
+            (line.compare(line.size() - suffixLength, suffixLength, Suffix) == 0))
+        {
+            const std::string stageName = line.substr(verbLength, line.size() - verbLength - suffixLength);
+            for (uint32_t stage = 0; stage < SpvGenStageCount; ++stage)
+            {
+                if (stageName == glslang::StageName(SpvGenStageToEShLanguage(static_cast<SpvGenStage>(stage))))
+                {
+                    *pPhase = verb.phase;
+                    *pStage = static_cast<SpvGenStage>(stage);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// =====================================================================================================================
+// Copy the diagnostics of another list, replaces the previous diagnostics
+SpvDiagnosticList& SpvDiagnosticList::operator=(
+    const SpvDiagnosticList& other)   // [in] Diagnostics to copy
+{
+    if (this != &other)
+    {
+        Clear();
+        Append(other);
+    }
+    return *this;
+}
+
+// =====================================================================================================================
+// Parse the diagnostics of an info log and add them to the list. Each call starts a new section of the log.
+void SpvDiagnosticList::AddLog(
+    const char* pLog,    // [in] Info log of a shader or program, or a message of spvgen
+    Phase       phase,   // Compile step the log comes from
+    SpvGenStage stage)   // Stage the log belongs to, SpvGenStageInvalid if it has none
+{
+    Origin origin = { phase, sectionCount++, -1 };
+    const char* pLine = pLog;
+    while (*pLine != '\0')
+    {
+        const char* pLineEnd = strchr(pLine, '\n');
+        if (pLineEnd == nullptr)
+        {
+            pLineEnd = pLine + strlen(pLine);
+        }
+
+        std::string line(pLine, pLineEnd);
+        pLine = (*pLineEnd == '\n') ? pLineEnd + 1 : pLineEnd;
+
+        while ((line.empty() == false) && ((line.back() == ' ') || (line.back() == '\r') || (line.back() == '\t')))
+        {
+            line.pop_back();
+        }
+        if (line.empty())
+        {
+            continue;
+        }
+        if (ParseStageHeader(line, &origin.phase, &stage))
+        {
+            origin.section = sectionCount++;
+            continue;
+        }
+
+        SpvDiagnostic diagnostic = {};
+        diagnostic.severity = SpvDiagnosticSeverityInfo;
+        diagnostic.stage = stage;
+        origin.prefix = -1;
+
+        std::string message = line;
+        for (size_t i = 0; i < sizeof(SeverityPrefixes) / sizeof(SeverityPrefixes[0]); ++i)
+        {
+            const size_t prefixLength = strlen(SeverityPrefixes[i].pPrefix);
+            if (line.compare(0, prefixLength, SeverityPrefixes[i].pPrefix) == 0)
+            {
+                diagnostic.severity = SeverityPrefixes[i].severity;
+                origin.prefix = static_cast<int32_t>(i);
+                message = line.substr(prefixLength);
+                break;
+            }
+        }
+
+        // Only the text in front of the first ": " may be a location, messages quote code which contains colons
+        std::string file;
+        const size_t locationEnd = message.find(": ");
+        if ((locationEnd != std::string::npos) &&
+            ParseLocation(message.substr(0, locationEnd), &file, &diagnostic.line, &diagnostic.column))
+        {
+            message.erase(0, locationEnd + 2);
+        }
+
+        AddDiagnostic(diagnostic, origin, file, message);
+    }
+}
+
+// =====================================================================================================================
+// Add the diagnostics of another list, they keep their own sections
+void SpvDiagnosticList::Append(
+    const SpvDiagnosticList& other)   // [in] Diagnostics to add
+{
+    for (size_t i = 0; i < other.diagnostics.size(); ++i)
+    {
+        Origin origin = other.origins[i];
+        origin.section += sectionCount;
+        AddDiagnostic(other.diagnostics[i], origin, other.diagnostics[i].pFile, other.diagnostics[i].pMessage);
+    }
+    sectionCount += other.sectionCount;
+}
+
+// =====================================================================================================================
+// Remove all diagnostics
+void SpvDiagnosticList::Clear()
+{
+    diagnostics.clear();
+    origins.clear();
+    strings.clear();
+    sectionCount = 0;
+}
+
+// =====================================================================================================================
+// Format the diagnostics as a text log, each section of a stage is preceded by a "Compiling <stage> stage:" or
+// "Linking <stage> stage:" header
+void SpvDiagnosticList::Format(
+    std::string* pLog   // [out] Formatted log
+    ) const
+{
+    pLog->clear();
+
+    uint32_t section = UINT32_MAX;
+    char buffer[64];
+    for (size_t i = 0; i < diagnostics.size(); ++i)
+    {
+        const SpvDiagnostic& diagnostic = diagnostics[i];
+        const Origin& origin = origins[i];
+        if ((origin.section != section) && (origin.phase != PhaseText) && (diagnostic.stage != SpvGenStageInvalid))
+        {
+            *pLog += (origin.phase == PhaseCompile) ? "Compiling " : "Linking ";
+            *pLog += glslang::StageName(SpvGenStageToEShLanguage(diagnostic.stage));
+            *pLog += " stage:\n";
+        }
+        section = origin.section;
+
+        if (origin.prefix >= 0)
+        {
+            *pLog += SeverityPrefixes[origin.prefix].pPrefix;
+        }
+        if (diagnostic.pFile[0] != '\0')
+        {
+            *pLog += diagnostic.pFile;
+            sprintf(buffer, ":%u", diagnostic.line);
+            *pLog += buffer;
+            if (diagnostic.column != 0)
+            {
+                sprintf(buffer, ":%u", diagnostic.column);
+                *pLog += buffer;
+            }
+            *pLog += ": ";
+        }
+        *pLog += diagnostic.pMessage;
+        *pLog += '\n';
+    }
+}
+
+// Fixed part of a serialized diagnostic, followed by its file name and message
+struct SerializedDiagnostic
+{
+    uint32_t severity;
+    uint32_t stage;
+    uint32_t line;
+    uint32_t column;
+    uint32_t phase;
+    uint32_t section;
+    int32_t  prefix;
+    uint32_t fileLength;
+    uint32_t messageLength;
+};
+
+// =====================================================================================================================
+// Size of the serialized diagnostics in bytes
+size_t SpvDiagnosticList::GetSerializedSize() const
+{
+    size_t size = sizeof(uint32_t) * 2;
+    for (const SpvDiagnostic& diagnostic : diagnostics)
+    {
+        size += sizeof(SerializedDiagnostic) + strlen(diagnostic.pFile) + strlen(diagnostic.pMessage);
+    }
+    return size;
+}
+
+// =====================================================================================================================
+// Serialize the diagnostics: the diagnostic and section count, then each diagnostic
+void SpvDiagnosticList::Serialize(
+    void* pData   // [out] Buffer of GetSerializedSize() bytes
+    ) const
+{
+    uint8_t* pBytes = static_cast<uint8_t*>(pData);
+    const uint32_t counts[2] = { GetCount(), sectionCount };
+    memcpy(pBytes, counts, sizeof(counts));
+    pBytes += sizeof(counts);
+
+    for (size_t i = 0; i < diagnostics.size(); ++i)
+    {
+        const SpvDiagnostic& diagnostic = diagnostics[i];
+        SerializedDiagnostic record = {};
+        record.severity = diagnostic.severity;
+        record.stage = diagnostic.stage;
+        record.line = diagnostic.line;
+        record.column = diagnostic.column;
+        record.phase = origins[i].phase;
+        record.section = origins[i].section;
+        record.prefix = origins[i].prefix;
+        record.fileLength = static_cast<uint32_t>(strlen(diagnostic.pFile));
+        record.messageLength = static_cast<uint32_t>(strlen(diagnostic.pMessage));
+
+        memcpy(pBytes, &record, sizeof(record));
+        pBytes += sizeof(record);
+        memcpy(pBytes, diagnostic.pFile, record.fileLength);
+        pBytes += record.fileLength;
+        memcpy(pBytes, diagnostic.pMessage, record.messageLength);
+        pBytes += record.messageLength;
+    }
+}
+
+// =====================================================================================================================
+// Restore diagnostics written by Serialize, replaces the previous diagnostics. Returns false if the data is damaged,
+// the list is empty then.
+bool SpvDiagnosticList::Deserialize(
+    const void* pData,      // [in] Serialized diagnostics
+    size_t      dataSize)   // Size of the data in bytes
+{
+    Clear();
+
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    const uint8_t* pEnd = pBytes + dataSize;
+    uint32_t counts[2] = {};
+    if (dataSize < sizeof(counts))
+    {
+        return false;
+    }
+    memcpy(counts, pBytes, sizeof(counts));
+    pBytes += sizeof(counts);
+
+    const int32_t prefixCount = static_cast<int32_t>(sizeof(SeverityPrefixes) / sizeof(SeverityPrefixes[0]));
+    bool valid = true;
+    for (uint32_t i = 0; valid && (i < counts[0]); ++i)
+    {
+        SerializedDiagnostic record = {};
+        valid = (static_cast<size_t>(pEnd - pBytes) >= sizeof(record));
+        if (valid)
+        {
+            memcpy(&record, pBytes, sizeof(record));
+            pBytes += sizeof(record);
+            valid = (record.severity <= SpvDiagnosticSeverityInfo) &&
+                    ((record.stage < SpvGenStageCount) || (record.stage == SpvGenStageInvalid)) &&
+                    (record.phase <= PhaseLink) &&
+                    (record.section < counts[1]) &&
+                    (record.prefix >= -1) && (record.prefix < prefixCount) &&
+                    (static_cast<uint64_t>(record.fileLength) + record.messageLength <=
+                     static_cast<uint64_t>(pEnd - pBytes));
+        }
+
+        if (valid)
+        {
+            SpvDiagnostic diagnostic = {};
+            diagnostic.severity = static_cast<SpvDiagnosticSeverity>(record.severity);
+            diagnostic.stage = static_cast<SpvGenStage>(record.stage);
+            diagnostic.line = record.line;
+            diagnostic.column = record.column;
+            const Origin origin = { static_cast<Phase>(record.phase), record.section, record.prefix };
+            const std::string file(reinterpret_cast<const char*>(pBytes), record.fileLength);
+            pBytes += record.fileLength;
+            const std::string message(reinterpret_cast<const char*>(pBytes), record.messageLength);
+            pBytes += record.messageLength;
+            AddDiagnostic(diagnostic, origin, file, message);
+        }
+    }
+
+    valid = valid && (pBytes == pEnd);
+    if (valid)
+    {
+        sectionCount = counts[1];
+    }
+    else
+    {
+        Clear();
+    }
+    return valid;
+}
+
+// =====================================================================================================================
+// Add a diagnostic, its strings are copied into the string pool
+void SpvDiagnosticList::AddDiagnostic(
+    const SpvDiagnostic& diagnostic,   // [in] Diagnostic, its string pointers are ignored
+    const Origin&        origin,       // [in] How the diagnostic is formatted
+    const std::string&   file,         // [in] Source string name or index, empty if unknown
+    const std::string&   message)      // [in] Message text
+{
+    strings.push_back(file);
+    const char* pFile = strings.back().c_str();
+    strings.push_back(message);
+    const char* pMessage = strings.back().c_str();
+
+    diagnostics.push_back(diagnostic);
+    diagnostics.back().pFile = pFile;
+    diagnostics.back().pMessage = pMessage;
+    origins.push_back(origin);
+}
@@ -0,0 +1,108 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  diagnostics.h
+* @brief SPVGEN header file: contains the declaration of the structured diagnostics of program logs.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "spvgen.h"
+
+// =====================================================================================================================
+// Represents the compile and link log of a program as structured diagnostics.
+//
+// The glslang info logs are parsed when they are captured, the text log is only formatted from the diagnostics when it
+// is queried. Lines starting with a severity prefix ("ERROR: ", "WARNING: ", ...) become diagnostics with the source
+// location split off, other non-empty lines become informational diagnostics. A "Compiling <stage> stage:", "Linking
+// <stage> stage:" or "Linked <stage> stage:" line in a log sets the stage of the lines which follow it.
+class SpvDiagnosticList
+{
+public:
+    // Compile step an info log comes from
+    enum Phase : uint32_t
+    {
+        PhaseText,      // Message of spvgen
+        PhaseCompile,   // Info log of a shader
+        PhaseLink,      // Info log of a program
+    };
+
+    SpvDiagnosticList() = default;
+    SpvDiagnosticList(const SpvDiagnosticList& other) { Append(other); }
+    SpvDiagnosticList(SpvDiagnosticList&& other) = default;
+
+    SpvDiagnosticList& operator=(const SpvDiagnosticList& other);
+    SpvDiagnosticList& operator=(SpvDiagnosticList&& other) = default;
+
+    // Parse the diagnostics of an info log and add them to the list
+    void AddLog(const char* pLog, Phase phase, SpvGenStage stage);
+
+    // Add the diagnostics of another list
+    void Append(const SpvDiagnosticList& other);
+
+    void Clear();
+
+    // Format the diagnostics as a text log
+    void Format(std::string* pLog) const;
+
+    // Size of the serialized diagnostics in bytes
+    size_t GetSerializedSize() const;
+
+    // Serialize the diagnostics, the buffer must hold GetSerializedSize() bytes
+    void Serialize(void* pData) const;
+
+    // Restore diagnostics written by Serialize, replaces the previous diagnostics. Returns false if the data is
+    // damaged.
+    bool Deserialize(const void* pData, size_t dataSize);
+
+    uint32_t GetCount() const { return static_cast<uint32_t>(diagnostics.size()); }
+    const SpvDiagnostic* GetData() const { return diagnostics.empty() ? nullptr : diagnostics.data(); }
+
+private:
+    // How a diagnostic is formatted back into a log line
+    struct Origin
+    {
+        Phase    phase;
+        uint32_t section;   // Index of the info log section the diagnostic belongs to
+        int32_t  prefix;    // Index of the severity prefix of the line, -1 if it has none
+    };
+
+    void AddDiagnostic(const SpvDiagnostic& diagnostic,
+                       const Origin&        origin,
+                       const std::string&   file,
+                       const std::string&   message);
+
+    std::vector<SpvDiagnostic> diagnostics;
+    std::vector<Origin>        origins;        // Origin of each diagnostic
+    std::deque<std::string>    strings;        // File names and messages, a deque never moves its elements
+    uint32_t                   sectionCount = 0;
+};
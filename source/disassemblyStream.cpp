@@ -0,0 +1,194 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  disassemblyStream.cpp
+* @brief SPVGEN source file: contains the implementation of the piecewise SPIR-V disassembler.
+***********************************************************************************************************************
+*/
+#include "disassemblyStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// SPIR-V layout constants, see the "Physical Layout of a SPIR-V Module" section of the specification
+static const size_t   HeaderWordCount = 5;
+static const uint16_t OpFunction = 54;
+static const uint16_t OpFunctionEnd = 56;
+
+// Minimum size of a group of functions disassembled in one go, it trades the memory of a piece of text against the
+// cost of disassembling the global part of the module once more per group. A group is never smaller than the global
+// part either, so the repeated global parts cost at most as much as the functions themselves.
+static const size_t   FunctionGroupWordCount = 16 * 1024;
+
+// Module layout collected by the parse before the disassembly
+struct SpvModuleLayout
+{
+    size_t              globalWordCount;   // Words of the header and of the instructions in front of the first function
+    size_t              globalLineCount;   // Lines of the text of the instructions in front of the first function
+    size_t              wordOffset;        // Offset of the next instruction while parsing
+    bool                inFunctions;       // The first function has been reached while parsing
+    std::vector<size_t> groupEnds;         // End offset of each group of functions
+};
+
+// =====================================================================================================================
+// Count the line breaks in the string operands of an instruction, the disassembler prints them as they are
+static size_t CountLineBreaks(
+    const spv_parsed_instruction_t* pInstruction)  // [in] Parsed instruction
+{
+    size_t count = 0;
+    for (uint16_t i = 0; i < pInstruction->num_operands; ++i)
+    {
+        const spv_parsed_operand_t& operand = pInstruction->operands[i];
+        if (operand.type == SPV_OPERAND_TYPE_LITERAL_STRING)
+        {
+            const char* pString = reinterpret_cast<const char*>(pInstruction->words + operand.offset);
+            const char* pStringEnd = pString + operand.num_words * sizeof(uint32_t);
+            count += std::count(pString, std::find(pString, pStringEnd, '\0'), '\n');
+        }
+    }
+    return count;
+}
+
+// =====================================================================================================================
+// Parse callback which records the global part and the function groups of the module
+static spv_result_t RecordInstruction(
+    void*                           pUserData,     // [in] Module layout
+    const spv_parsed_instruction_t* pInstruction)  // [in] Parsed instruction
+{
+    SpvModuleLayout* pLayout = static_cast<SpvModuleLayout*>(pUserData);
+    if (pInstruction->opcode == OpFunction)
+    {
+        pLayout->inFunctions = true;
+    }
+
+    pLayout->wordOffset += pInstruction->num_words;
+
+    if (pLayout->inFunctions == false)
+    {
+        pLayout->globalWordCount = pLayout->wordOffset;
+        pLayout->globalLineCount += 1 + CountLineBreaks(pInstruction);
+    }
+    else if (pInstruction->opcode == OpFunctionEnd)
+    {
+        const size_t groupBegin = pLayout->groupEnds.empty() ? pLayout->globalWordCount : pLayout->groupEnds.back();
+        const size_t minGroupWordCount = std::max(FunctionGroupWordCount, pLayout->globalWordCount);
+        if (pLayout->wordOffset - groupBegin >= minGroupWordCount)
+        {
+            pLayout->groupEnds.push_back(pLayout->wordOffset);
+        }
+    }
+    return SPV_SUCCESS;
+}
+
+// =====================================================================================================================
+// Disassemble a module, and pass its text to the output, without the lines of the specified number of leading
+// instructions.
+//
+// NOTE: Every instruction is printed on a line of its own, with the line breaks of its string literals as they are, so
+// the lines to skip are counted by the parse of the binary.
+static spv_result_t DisassembleModule(
+    spv_const_context    context,
+    const uint32_t*      pCode,
+    size_t               wordCount,
+    uint32_t             options,
+    size_t               skipLineCount,   // Number of leading lines which aren't passed to the output
+    const SpvTextOutput& output,
+    spv_diagnostic*      pDiagnostic)
+{
+    spv_text text = nullptr;
+    spv_result_t result = spvBinaryToText(context, pCode, wordCount, options, &text, pDiagnostic);
+    if (result == SPV_SUCCESS)
+    {
+        const char* pText = text->str;
+        const char* pEnd = text->str + text->length;
+        for (size_t i = 0; (i < skipLineCount) && (result == SPV_SUCCESS); ++i)
+        {
+            const char* pNewLine = static_cast<const char*>(memchr(pText, '\n', pEnd - pText));
+            if (pNewLine == nullptr)
+            {
+                result = SPV_ERROR_INTERNAL;
+            }
+            pText = (pNewLine != nullptr) ? pNewLine + 1 : pEnd;
+        }
+
+        if ((result == SPV_SUCCESS) && (pText < pEnd) && (output(pText, pEnd - pText) == false))
+        {
+            result = SPV_REQUESTED_TERMINATION;
+        }
+    }
+    spvTextDestroy(text);
+    return result;
+}
+
+// =====================================================================================================================
+// Disassemble a SPIR-V binary piece by piece, returns SPV_REQUESTED_TERMINATION if the output stopped it
+spv_result_t DisassembleSpirvStream(
+    spv_const_context    context,       // [in] SPIRV-Tools context of the target environment of the binary
+    const uint32_t*      pCode,         // [in] SPIR-V binary
+    size_t               wordCount,     // Number of words of the binary
+    uint32_t             options,       // Options of spvBinaryToText(), SPV_BINARY_TO_TEXT_OPTION_PRINT isn't allowed
+    const SpvTextOutput& output,        // [in] Receives the text, in order
+    spv_diagnostic*      pDiagnostic)   // [out] Diagnostic of a failure
+{
+    SpvModuleLayout layout = {};
+    layout.wordOffset = HeaderWordCount;
+    layout.globalWordCount = HeaderWordCount;
+    spv_result_t result = spvBinaryParse(context, &layout, pCode, wordCount, nullptr, RecordInstruction, pDiagnostic);
+    if (result != SPV_SUCCESS)
+    {
+        return result;
+    }
+
+    // The last group takes the remaining functions, and anything which follows them
+    if ((layout.groupEnds.empty() || (layout.groupEnds.back() < wordCount)) && (layout.globalWordCount < wordCount))
+    {
+        layout.groupEnds.push_back(wordCount);
+    }
+
+    // Header and global part
+    result = DisassembleModule(context, pCode, layout.globalWordCount, options, 0, output, pDiagnostic);
+
+    // Groups of functions, each behind a copy of the global part whose lines are skipped
+    std::vector<uint32_t> module;
+    size_t groupBegin = layout.globalWordCount;
+    for (size_t i = 0; (i < layout.groupEnds.size()) && (result == SPV_SUCCESS); ++i)
+    {
+        const size_t groupEnd = layout.groupEnds[i];
+        module.assign(pCode, pCode + layout.globalWordCount);
+        module.insert(module.end(), pCode + groupBegin, pCode + groupEnd);
+        result = DisassembleModule(context,
+                                   module.data(),
+                                   module.size(),
+                                   options | SPV_BINARY_TO_TEXT_OPTION_NO_HEADER,
+                                   layout.globalLineCount,
+                                   output,
+                                   pDiagnostic);
+        groupBegin = groupEnd;
+    }
+
+    return result;
+}
@@ -0,0 +1,63 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  disassemblyStream.h
+* @brief SPVGEN header file: contains the declaration of the piecewise SPIR-V disassembler.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "spirv-tools/libspirv.h"
+
+// Receives the disassembly text piece by piece, returns false to stop the disassembly
+typedef std::function<bool(const char* pText, size_t length)> SpvTextOutput;
+
+// =====================================================================================================================
+// Disassemble a SPIR-V binary with spvBinaryToText() piece by piece, so that the text of the whole module is never
+// held in memory at once.
+//
+// The module is split in front of its first OpFunction. The part before it (debug names, annotations, types, constants
+// and global variables) is disassembled once, together with the header. Groups of whole functions are then
+// disassembled as small modules which repeat that part, so that the friendly names, the literal types and the
+// indentation come out exactly as for the whole module. The small modules keep the logical layout of SPIR-V, the lines
+// of the repeated part are counted while parsing the binary and dropped from the output.
+//
+// A group is at least as large as the global part, so the whole disassembly costs at most about twice as much as
+// disassembling the module in one go, and the text held at once is at most about twice the text of a group.
+//
+// NOTE: The binary is parsed up front, so an invalid binary fails with the diagnostic of the whole module before any
+// text is written.
+spv_result_t DisassembleSpirvStream(
+    spv_const_context    context,
+    const uint32_t*      pCode,
+    size_t               wordCount,
+    uint32_t             options,
+    const SpvTextOutput& output,
+    spv_diagnostic*      pDiagnostic);
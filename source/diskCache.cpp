@@ -0,0 +1,501 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  diskCache.cpp
+* @brief SPVGEN source file: contains the implementation of the persistent on-disk compile result cache.
+***********************************************************************************************************************
+*/
+#include "diskCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char* IndexFileName = "spvgen.idx";
+static const char* BlobFileExt   = ".spvc";
+
+// =====================================================================================================================
+SpvDiskCache::SpvDiskCache(
+    const char*       pCacheDir,    // [in] Cache directory, it is created if it doesn't exist
+    uint64_t          maxSize,      // Maximum total size of the cache entries in bytes
+    const SpvHash128& versionKey)   // Hash of the library versions, a mismatching index is discarded
+    :
+    cacheDir(pCacheDir),
+    maxSize(maxSize),
+    versionKey(versionKey),
+    validCount(0),
+    deletedCount(0),
+    hitCount(0),
+    missCount(0)
+{
+}
+
+// =====================================================================================================================
+// Write a file atomically by writing a temporary file in the same directory and renaming it
+static bool WriteFileAtomic(
+    const std::string& fileName,    // Final file name
+    const void*        pData,       // [in] File content
+    size_t             size)        // Size of the file content in bytes
+{
+    // The temporary name must be unique among threads and processes writing the same entry
+    const uint64_t unique = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^
+                            static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%016llx.tmp", static_cast<unsigned long long>(unique));
+    const std::string tempName = fileName + suffix;
+
+    {
+        std::ofstream file(tempName, std::ios::binary | std::ios::trunc);
+        if (file.good() == false)
+        {
+            return false;
+        }
+        file.write(static_cast<const char*>(pData), size);
+        file.flush();
+        if (file.good() == false)
+        {
+            file.close();
+            std::error_code ec;
+            fs::remove(tempName, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempName, fileName, ec);
+    if (ec)
+    {
+        fs::remove(tempName, ec);
+        return false;
+    }
+    return true;
+}
+
+// =====================================================================================================================
+// Open the index of the cache directory, create or reset it if it is missing or outdated
+bool SpvDiskCache::Init()
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    std::error_code ec;
+    fs::create_directories(cacheDir, ec);
+
+    const std::string indexPath = (fs::path(cacheDir) / IndexFileName).string();
+    const size_t indexSize = sizeof(IndexHeader) + sizeof(IndexSlot) * SlotCount;
+
+    bool valid = index.Open(indexPath.c_str(), true) && (index.GetSize() == indexSize);
+    if (valid)
+    {
+        const IndexHeader* pHeader = GetHeader();
+        valid = (pHeader->magic == IndexMagic) &&
+                (pHeader->formatVersion == FormatVersion) &&
+                (pHeader->versionKeyLo == versionKey.lo) &&
+                (pHeader->versionKeyHi == versionKey.hi) &&
+                (pHeader->slotCount == SlotCount);
+    }
+
+    if (valid == false)
+    {
+        index.Close();
+        if ((CreateIndex() == false) || (index.Open(indexPath.c_str(), true) == false))
+        {
+            return false;
+        }
+    }
+
+    validCount = 0;
+    deletedCount = 0;
+    const IndexSlot* pSlots = GetSlots();
+    for (uint32_t i = 0; i < SlotCount; ++i)
+    {
+        if (pSlots[i].state == SlotStateValid)
+        {
+            ++validCount;
+        }
+        else if (pSlots[i].state == SlotStateDeleted)
+        {
+            ++deletedCount;
+        }
+    }
+
+    return true;
+}
+
+// =====================================================================================================================
+// Create an empty index file and remove all entries of the previous index
+bool SpvDiskCache::CreateIndex()
+{
+    std::vector<uint8_t> data(sizeof(IndexHeader) + sizeof(IndexSlot) * SlotCount, 0);
+    IndexHeader* pHeader = reinterpret_cast<IndexHeader*>(data.data());
+    pHeader->magic         = IndexMagic;
+    pHeader->formatVersion = FormatVersion;
+    pHeader->versionKeyLo  = versionKey.lo;
+    pHeader->versionKeyHi  = versionKey.hi;
+    pHeader->slotCount     = SlotCount;
+
+    // The entries of the old index can't be found any more, remove them
+    std::error_code ec;
+    for (fs::directory_iterator it(cacheDir, ec), end; (ec.value() == 0) && (it != end); it.increment(ec))
+    {
+        if (it->path().extension() == BlobFileExt)
+        {
+            std::error_code removeEc;
+            fs::remove(it->path(), removeEc);
+        }
+    }
+
+    return WriteFileAtomic((fs::path(cacheDir) / IndexFileName).string(), data.data(), data.size());
+}
+
+// =====================================================================================================================
+// Get the file name of the blob of the specified key
+std::string SpvDiskCache::GetBlobPath(
+    const SpvHash128& key   // Entry key
+    ) const
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx%016llx%s",
+             static_cast<unsigned long long>(key.hi), static_cast<unsigned long long>(key.lo), BlobFileExt);
+    return (fs::path(cacheDir) / name).string();
+}
+
+// =====================================================================================================================
+// Find the valid slot of the specified key, returns null if there is none
+//
+// NOTE: The lock must be held by the caller.
+SpvDiskCache::IndexSlot* SpvDiskCache::FindSlot(
+    const SpvHash128& key)  // Entry key
+{
+    IndexSlot* pSlots = GetSlots();
+    for (uint32_t i = 0; i < SlotCount; ++i)
+    {
+        IndexSlot* pSlot = &pSlots[(key.lo + i) % SlotCount];
+        if (pSlot->state == SlotStateEmpty)
+        {
+            break;
+        }
+        if ((pSlot->state == SlotStateValid) && (pSlot->keyLo == key.lo) && (pSlot->keyHi == key.hi))
+        {
+            return pSlot;
+        }
+    }
+    return nullptr;
+}
+
+// =====================================================================================================================
+// Find a free slot for the specified key, returns null if the table is full
+//
+// NOTE: The lock must be held by the caller, and the key must not be in the table yet.
+SpvDiskCache::IndexSlot* SpvDiskCache::AllocSlot(
+    const SpvHash128& key)  // Entry key
+{
+    IndexSlot* pSlots = GetSlots();
+    for (uint32_t i = 0; i < SlotCount; ++i)
+    {
+        IndexSlot* pSlot = &pSlots[(key.lo + i) % SlotCount];
+        if (pSlot->state != SlotStateValid)
+        {
+            if (pSlot->state == SlotStateDeleted)
+            {
+                --deletedCount;
+            }
+            return pSlot;
+        }
+    }
+    return nullptr;
+}
+
+// =====================================================================================================================
+// Remove the entry of a valid slot, including its blob file
+//
+// NOTE: The lock must be held by the caller.
+void SpvDiskCache::RemoveSlot(
+    IndexSlot* pSlot)   // [in] Slot to remove
+{
+    SpvHash128 key = { pSlot->keyLo, pSlot->keyHi };
+    std::error_code ec;
+    fs::remove(GetBlobPath(key), ec);
+
+    IndexHeader* pHeader = GetHeader();
+    pHeader->totalSize -= std::min<uint64_t>(pHeader->totalSize, pSlot->size);
+    pSlot->state = SlotStateDeleted;
+    --validCount;
+    ++deletedCount;
+}
+
+// =====================================================================================================================
+// Evict the least recently used entries until the total size is at most targetSize and at least a quarter of the
+// slots are free
+//
+// NOTE: The lock must be held by the caller.
+void SpvDiskCache::Evict(
+    uint64_t targetSize)    // Target total size in bytes
+{
+    IndexHeader* pHeader = GetHeader();
+    IndexSlot* pSlots = GetSlots();
+
+    std::vector<IndexSlot*> validSlots;
+    for (uint32_t i = 0; i < SlotCount; ++i)
+    {
+        if (pSlots[i].state == SlotStateValid)
+        {
+            validSlots.push_back(&pSlots[i]);
+        }
+    }
+    std::sort(validSlots.begin(),
+              validSlots.end(),
+              [](const IndexSlot* pLeft, const IndexSlot* pRight) { return pLeft->lastUse < pRight->lastUse; });
+
+    const size_t maxSlotCount = SlotCount - SlotCount / 4;
+    size_t remainingCount = validSlots.size();
+    for (IndexSlot* pSlot : validSlots)
+    {
+        if ((pHeader->totalSize <= targetSize) && (remainingCount <= maxSlotCount))
+        {
+            break;
+        }
+        RemoveSlot(pSlot);
+        --remainingCount;
+    }
+
+    if (deletedCount > SlotCount / 4)
+    {
+        Rehash();
+    }
+}
+
+// =====================================================================================================================
+// Re-insert all valid slots to get rid of the deleted slots
+//
+// NOTE: The lock must be held by the caller.
+void SpvDiskCache::Rehash()
+{
+    IndexSlot* pSlots = GetSlots();
+
+    std::vector<IndexSlot> validSlots;
+    for (uint32_t i = 0; i < SlotCount; ++i)
+    {
+        if (pSlots[i].state == SlotStateValid)
+        {
+            validSlots.push_back(pSlots[i]);
+        }
+    }
+
+    memset(pSlots, 0, sizeof(IndexSlot) * SlotCount);
+    deletedCount = 0;
+
+    for (const IndexSlot& slot : validSlots)
+    {
+        SpvHash128 key = { slot.keyLo, slot.keyHi };
+        IndexSlot* pSlot = AllocSlot(key);
+        *pSlot = slot;
+    }
+}
+
+// =====================================================================================================================
+// Find the entry for the specified key, returns false on a miss
+bool SpvDiskCache::Find(
+    const SpvHash128&     key,      // Entry key
+    SpvCompileCacheEntry* pEntry)   // [out] Cached compile result
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        IndexSlot* pSlot = index.IsOpen() ? FindSlot(key) : nullptr;
+        if (pSlot == nullptr)
+        {
+            ++missCount;
+            return false;
+        }
+        pSlot->lastUse = ++GetHeader()->useCounter;
+    }
+
+    // The blob is read through a read-only mapping, the SPIR-V words are only copied once into the result
+    SpvMappedFile blob;
+    bool valid = blob.Open(GetBlobPath(key).c_str(), false) && (blob.GetSize() >= sizeof(BlobHeader));
+    if (valid)
+    {
+        const BlobHeader* pHeader = static_cast<const BlobHeader*>(blob.GetData());
+        const uint8_t* pPayload = reinterpret_cast<const uint8_t*>(pHeader + 1);
+        const size_t payloadSize = blob.GetSize() - sizeof(BlobHeader);
+
+        SpvHasher hasher;
+        hasher.Update(pPayload, payloadSize);
+        const SpvHash128 checksum = hasher.Finalize();
+
+        valid = (pHeader->magic == BlobMagic) &&
+                (pHeader->formatVersion == FormatVersion) &&
+                (pHeader->keyLo == key.lo) &&
+                (pHeader->keyHi == key.hi) &&
+                (pHeader->checksumLo == checksum.lo) &&
+                (pHeader->checksumHi == checksum.hi) &&
+                (static_cast<uint64_t>(pHeader->stageCount) * sizeof(uint32_t) <= payloadSize);
+
+        if (valid)
+        {
+            const uint32_t* pWordCounts = reinterpret_cast<const uint32_t*>(pPayload);
+            const uint32_t* pWords = pWordCounts + pHeader->stageCount;
+            uint64_t wordCount = 0;
+            for (uint32_t i = 0; i < pHeader->stageCount; ++i)
+            {
+                wordCount += pWordCounts[i];
+            }
+            valid = ((pHeader->stageCount + wordCount) * sizeof(uint32_t) + pHeader->diagnosticsSize == payloadSize);
+
+            if (valid)
+            {
+                pEntry->spirvs.resize(pHeader->stageCount);
+                for (uint32_t i = 0; i < pHeader->stageCount; ++i)
+                {
+                    pEntry->spirvs[i].assign(pWords, pWords + pWordCounts[i]);
+                    pWords += pWordCounts[i];
+                }
+                valid = pEntry->diagnostics.Deserialize(pWords, pHeader->diagnosticsSize);
+            }
+        }
+    }
+
+    if (valid == false)
+    {
+        // The blob is missing or damaged, drop the entry
+        std::lock_guard<std::mutex> guard(lock);
+        IndexSlot* pSlot = FindSlot(key);
+        if (pSlot != nullptr)
+        {
+            RemoveSlot(pSlot);
+        }
+        ++missCount;
+        return false;
+    }
+
+    ++hitCount;
+    return true;
+}
+
+// =====================================================================================================================
+// Add an entry, least recently used entries are evicted if the cache exceeds its size limit
+void SpvDiskCache::Store(
+    const SpvHash128&           key,    // Entry key
+    const SpvCompileCacheEntry& entry)  // Compile result
+{
+    if (index.IsOpen() == false)
+    {
+        return;
+    }
+
+    // Serialize the blob
+    const uint32_t stageCount = static_cast<uint32_t>(entry.spirvs.size());
+    size_t wordCount = stageCount;
+    for (const auto& spirv : entry.spirvs)
+    {
+        wordCount += spirv.size();
+    }
+    const size_t diagnosticsSize = entry.diagnostics.GetSerializedSize();
+    const size_t payloadSize = wordCount * sizeof(uint32_t) + diagnosticsSize;
+    const size_t blobSize = sizeof(BlobHeader) + payloadSize;
+    if ((blobSize > UINT32_MAX) || (blobSize > maxSize))
+    {
+        return;
+    }
+
+    std::vector<uint8_t> data(blobSize);
+    uint32_t* pWords = reinterpret_cast<uint32_t*>(data.data() + sizeof(BlobHeader));
+    for (uint32_t i = 0; i < stageCount; ++i)
+    {
+        *pWords++ = static_cast<uint32_t>(entry.spirvs[i].size());
+    }
+    for (const auto& spirv : entry.spirvs)
+    {
+        if (spirv.empty() == false)
+        {
+            memcpy(pWords, spirv.data(), spirv.size() * sizeof(uint32_t));
+            pWords += spirv.size();
+        }
+    }
+    entry.diagnostics.Serialize(pWords);
+
+    SpvHasher hasher;
+    hasher.Update(data.data() + sizeof(BlobHeader), payloadSize);
+    const SpvHash128 checksum = hasher.Finalize();
+
+    BlobHeader* pHeader = reinterpret_cast<BlobHeader*>(data.data());
+    pHeader->magic           = BlobMagic;
+    pHeader->formatVersion   = FormatVersion;
+    pHeader->keyLo           = key.lo;
+    pHeader->keyHi           = key.hi;
+    pHeader->checksumLo      = checksum.lo;
+    pHeader->checksumHi      = checksum.hi;
+    pHeader->stageCount      = stageCount;
+    pHeader->diagnosticsSize = static_cast<uint32_t>(diagnosticsSize);
+
+    // Write the blob before it becomes visible in the index
+    if (WriteFileAtomic(GetBlobPath(key), data.data(), data.size()) == false)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    IndexHeader* pIndexHeader = GetHeader();
+
+    IndexSlot* pSlot = FindSlot(key);
+    if (pSlot != nullptr)
+    {
+        // Another thread stored the same entry, the blob has just been replaced by an identical one
+        pIndexHeader->totalSize -= std::min<uint64_t>(pIndexHeader->totalSize, pSlot->size);
+    }
+    else
+    {
+        // Keep the table sparse enough for short probe sequences
+        if (validCount >= SlotCount - SlotCount / 4)
+        {
+            Evict(maxSize);
+        }
+        pSlot = AllocSlot(key);
+        if (pSlot == nullptr)
+        {
+            return;
+        }
+        pSlot->keyLo = key.lo;
+        pSlot->keyHi = key.hi;
+        ++validCount;
+    }
+
+    pSlot->size = static_cast<uint32_t>(blobSize);
+    pSlot->lastUse = ++pIndexHeader->useCounter;
+    pSlot->state = SlotStateValid;
+    pIndexHeader->totalSize += blobSize;
+
+    if (pIndexHeader->totalSize > maxSize)
+    {
+        // Evict a bit more than necessary, so that eviction doesn't run on every store
+        Evict(maxSize - maxSize / 8);
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  diskCache.h
+* @brief SPVGEN header file: contains the declaration of the persistent on-disk compile result cache.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include "compileCache.h"
+#include "hasher.h"
+#include "mappedFile.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+// =====================================================================================================================
+// Persistent cache of compile results in a directory.
+//
+// The directory holds an index file and one blob file per entry. The index is a fixed-size open-addressing hash table
+// which is memory-mapped on open, so a lookup is a probe of the mapped table followed by mapping the blob file of the
+// entry. Blob files are written to a temporary file and renamed, so a crash never leaves a partially written entry
+// behind, and every blob carries a checksum of its payload, so a stale or torn index slot only results in a miss.
+//
+// The index header stores the library version key, an index written by a different library version is discarded with
+// all its entries on open. Entries are evicted in least recently used order once the total size exceeds the limit.
+//
+// NOTE: The index is only protected against concurrent use within one process, several processes sharing one
+// directory may lose each other's index updates, which costs recompiles but never returns wrong results.
+class SpvDiskCache
+{
+public:
+    SpvDiskCache(const char* pCacheDir, uint64_t maxSize, const SpvHash128& versionKey);
+
+    // Open the index of the cache directory, create or reset it if it is missing or outdated
+    bool Init();
+
+    // Find the entry for the specified key, returns false on a miss
+    bool Find(const SpvHash128& key, SpvCompileCacheEntry* pEntry);
+
+    // Add an entry, least recently used entries are evicted if the cache exceeds its size limit
+    void Store(const SpvHash128& key, const SpvCompileCacheEntry& entry);
+
+    uint64_t GetHitCount() const { return hitCount; }
+    uint64_t GetMissCount() const { return missCount; }
+
+private:
+    static const uint32_t IndexMagic    = 0x58444943;   // "CIDX"
+    static const uint32_t BlobMagic     = 0x42505343;   // "CSPB"
+    static const uint32_t FormatVersion = 2;
+    static const uint32_t SlotCount     = 65536;
+
+    // Header of the index file
+    struct IndexHeader
+    {
+        uint32_t magic;
+        uint32_t formatVersion;
+        uint64_t versionKeyLo;
+        uint64_t versionKeyHi;
+        uint32_t slotCount;
+        uint32_t reserved;
+        uint64_t totalSize;     // Sum of the sizes of all valid entries in bytes
+        uint64_t useCounter;    // Logical clock for the LRU order
+    };
+
+    enum SlotState : uint32_t
+    {
+        SlotStateEmpty,
+        SlotStateValid,
+        SlotStateDeleted,
+    };
+
+    // Index slot of one entry
+    struct IndexSlot
+    {
+        uint64_t keyLo;
+        uint64_t keyHi;
+        uint64_t lastUse;
+        uint32_t size;          // Size of the blob file in bytes
+        uint32_t state;         // SlotState, written last when a slot is filled
+    };
+
+    // Header of a blob file, followed by the SPIR-V word count of each stage, the SPIR-V words of all stages and the
+    // serialized diagnostics of the program log
+    struct BlobHeader
+    {
+        uint32_t magic;
+        uint32_t formatVersion;
+        uint64_t keyLo;
+        uint64_t keyHi;
+        uint64_t checksumLo;    // Hash of everything after the header
+        uint64_t checksumHi;
+        uint32_t stageCount;
+        uint32_t diagnosticsSize;
+    };
+
+    bool CreateIndex();
+    IndexHeader* GetHeader() { return static_cast<IndexHeader*>(index.GetWritableData()); }
+    IndexSlot* GetSlots() { return reinterpret_cast<IndexSlot*>(GetHeader() + 1); }
+    IndexSlot* FindSlot(const SpvHash128& key);
+    IndexSlot* AllocSlot(const SpvHash128& key);
+    void RemoveSlot(IndexSlot* pSlot);
+    void Evict(uint64_t targetSize);
+    void Rehash();
+    std::string GetBlobPath(const SpvHash128& key) const;
+
+    std::string            cacheDir;
+    uint64_t               maxSize;
+    SpvHash128             versionKey;
+    SpvMappedFile          index;
+    std::mutex             lock;
+    uint32_t               validCount;      // Number of valid slots
+    uint32_t               deletedCount;    // Number of deleted slots, they lengthen the probe sequences
+    std::atomic<uint64_t>  hitCount;
+    std::atomic<uint64_t>  missCount;
+};
@@ -0,0 +1,545 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  fingerprint.cpp
+* @brief SPVGEN source file: contains the implementation of the canonical SPIR-V module fingerprint.
+***********************************************************************************************************************
+*/
+#include "fingerprint.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Opcodes of the instructions the canonical view treats specially, from the SPIR-V specification
+enum SpvFingerprintOpcode : uint16_t
+{
+    OpSourceContinued        = 2,
+    OpSource                 = 3,
+    OpSourceExtension        = 4,
+    OpName                   = 5,
+    OpMemberName             = 6,
+    OpString                 = 7,
+    OpLine                   = 8,
+    OpExtension              = 10,
+    OpExtInstImport          = 11,
+    OpExtInst                = 12,
+    OpEntryPoint             = 15,
+    OpExecutionMode          = 16,
+    OpCapability             = 17,
+    OpFunction               = 54,
+    OpDecorate               = 71,
+    OpMemberDecorate         = 72,
+    OpGroupDecorate          = 74,
+    OpGroupMemberDecorate    = 75,
+    OpNoLine                 = 317,
+    OpModuleProcessed        = 330,
+    OpExecutionModeId        = 331,
+    OpDecorateId             = 332,
+    OpDecorateString         = 5632,
+    OpMemberDecorateString   = 5633,
+};
+
+// Id which is referenced but never defined by a kept instruction
+static const uint32_t UndefinedId = UINT32_MAX;
+
+// Position of an ID which is never referenced by a function
+static const size_t UnusedPosition = SIZE_MAX;
+
+// Canonical view of a module, built while it is parsed
+struct SpvCanonicalModule
+{
+    // One kept instruction
+    struct Instruction
+    {
+        size_t   offset;      // Offset of the first word in words
+        uint32_t wordCount;
+        uint16_t opcode;
+        bool     unordered;   // The instruction is hashed regardless of its position
+        uint32_t resultId;    // Original result ID, 0 if the instruction has none
+        size_t   idBegin;     // Range of the offsets of its ID operands in idOffsets
+        size_t   idEnd;
+    };
+
+    // A declaration of the global part together with the OpLine instructions in front of it
+    struct Declaration
+    {
+        size_t     firstInstruction;   // Index of the first instruction, the declaration itself is the last one
+        size_t     instructionCount;
+        SpvHash128 contentHash;        // Hash of the declaration and of everything it references
+        size_t     firstUse;           // Position of the first reference of the result ID by a function
+    };
+
+    bool                     ignoreDebugInfo;
+    uint32_t                 version;
+    std::vector<uint32_t>    words;            // Words of the kept instructions
+    std::vector<size_t>      idOffsets;        // Offsets of the ID operands in words
+    std::vector<Instruction> instructions;
+    std::vector<uint32_t>    idMap;            // Canonical ID of each original ID, 0 if it isn't defined yet
+    std::vector<bool>        debugSets;        // The original ID is an extended instruction set of debug info
+};
+
+// =====================================================================================================================
+// Check whether an instruction is a debug instruction
+static bool IsDebugInstruction(
+    uint16_t opcode)
+{
+    switch (opcode)
+    {
+    case OpSourceContinued:
+    case OpSource:
+    case OpSourceExtension:
+    case OpName:
+    case OpMemberName:
+    case OpString:
+    case OpLine:
+    case OpNoLine:
+    case OpModuleProcessed:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// =====================================================================================================================
+// Check whether the position of an instruction has no meaning, the instructions of these kinds only reference IDs and
+// don't define any
+static bool IsUnorderedInstruction(
+    uint16_t opcode)
+{
+    switch (opcode)
+    {
+    case OpCapability:
+    case OpExtension:
+    case OpEntryPoint:
+    case OpExecutionMode:
+    case OpExecutionModeId:
+    case OpSourceContinued:
+    case OpSource:
+    case OpSourceExtension:
+    case OpName:
+    case OpMemberName:
+    case OpModuleProcessed:
+    case OpDecorate:
+    case OpMemberDecorate:
+    case OpGroupDecorate:
+    case OpGroupMemberDecorate:
+    case OpDecorateId:
+    case OpDecorateString:
+    case OpMemberDecorateString:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// =====================================================================================================================
+// Check whether an operand holds an ID
+static bool IsIdOperand(
+    spv_operand_type_t type)
+{
+    return (type == SPV_OPERAND_TYPE_ID) ||
+           (type == SPV_OPERAND_TYPE_TYPE_ID) ||
+           (type == SPV_OPERAND_TYPE_RESULT_ID) ||
+           (type == SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID) ||
+           (type == SPV_OPERAND_TYPE_SCOPE_ID) ||
+           (type == SPV_OPERAND_TYPE_OPTIONAL_ID);
+}
+
+// =====================================================================================================================
+// Parse callback which records the header of the module
+static spv_result_t RecordHeader(
+    void*            pUserData,   // [in] Canonical module
+    spv_endianness_t endian,
+    uint32_t         magic,
+    uint32_t         version,
+    uint32_t         generator,
+    uint32_t         idBound,
+    uint32_t         reserved)
+{
+    SpvCanonicalModule* pModule = static_cast<SpvCanonicalModule*>(pUserData);
+    pModule->version = version;
+    pModule->idMap.assign(idBound, 0);
+    pModule->debugSets.assign(idBound, false);
+    return SPV_SUCCESS;
+}
+
+// =====================================================================================================================
+// Parse callback which adds an instruction to the canonical view
+static spv_result_t RecordInstruction(
+    void*                           pUserData,      // [in] Canonical module
+    const spv_parsed_instruction_t* pInstruction)   // [in] Parsed instruction
+{
+    SpvCanonicalModule* pModule = static_cast<SpvCanonicalModule*>(pUserData);
+    const uint32_t* pWords = pInstruction->words;
+
+    if (pModule->ignoreDebugInfo)
+    {
+        if (IsDebugInstruction(pInstruction->opcode))
+        {
+            return SPV_SUCCESS;
+        }
+
+        if (pInstruction->opcode == OpExtInstImport)
+        {
+            // Operands: result ID, set name. The parser has checked that the name is null terminated.
+            const char* pSetName = reinterpret_cast<const char*>(pWords + 2);
+            const bool isDebugSet = (strncmp(pSetName, "NonSemantic.", 12) == 0) ||
+                                    (strcmp(pSetName, "DebugInfo") == 0) ||
+                                    (strncmp(pSetName, "OpenCL.DebugInfo.", 17) == 0);
+            if (isDebugSet && (pWords[1] < pModule->debugSets.size()))
+            {
+                pModule->debugSets[pWords[1]] = true;
+                return SPV_SUCCESS;
+            }
+        }
+        else if (pInstruction->opcode == OpExtInst)
+        {
+            // Operands: result type, result ID, set, instruction
+            if ((pWords[3] < pModule->debugSets.size()) && pModule->debugSets[pWords[3]])
+            {
+                return SPV_SUCCESS;
+            }
+        }
+    }
+
+    SpvCanonicalModule::Instruction instruction = {};
+    instruction.offset = pModule->words.size();
+    instruction.wordCount = pInstruction->num_words;
+    instruction.opcode = pInstruction->opcode;
+    instruction.unordered = IsUnorderedInstruction(pInstruction->opcode);
+    instruction.idBegin = pModule->idOffsets.size();
+    pModule->words.insert(pModule->words.end(), pWords, pWords + pInstruction->num_words);
+
+    for (uint16_t i = 0; i < pInstruction->num_operands; ++i)
+    {
+        const spv_parsed_operand_t& operand = pInstruction->operands[i];
+        if (IsIdOperand(operand.type))
+        {
+            pModule->idOffsets.push_back(instruction.offset + operand.offset);
+            const uint32_t id = pWords[operand.offset];
+            if ((operand.type == SPV_OPERAND_TYPE_RESULT_ID) && (id < pModule->idMap.size()))
+            {
+                instruction.resultId = id;
+            }
+        }
+    }
+    instruction.idEnd = pModule->idOffsets.size();
+    pModule->instructions.push_back(instruction);
+    return SPV_SUCCESS;
+}
+
+// =====================================================================================================================
+// Order of hashes in sorted sets
+static bool CompareHashes(
+    const SpvHash128& left,
+    const SpvHash128& right)
+{
+    return (left.hi != right.hi) ? (left.hi < right.hi) : (left.lo < right.lo);
+}
+
+// =====================================================================================================================
+// Check whether an instruction annotates the ID of its first operand, its literal operands then become part of the
+// content of that ID
+static bool IsAnnotationInstruction(
+    uint16_t opcode)
+{
+    switch (opcode)
+    {
+    case OpName:
+    case OpMemberName:
+    case OpDecorate:
+    case OpMemberDecorate:
+    case OpDecorateId:
+    case OpDecorateString:
+    case OpMemberDecorateString:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// =====================================================================================================================
+// Hash the words of an instruction, the ID operands are replaced by the content hashes of the IDs they reference. The
+// result ID, and with skipIds every ID operand, is left out.
+static void HashInstructionContent(
+    const SpvCanonicalModule&              module,
+    const SpvCanonicalModule::Instruction& instruction,
+    const std::vector<SpvHash128>&         contentHashes,   // [in] Content hash of each original ID
+    const std::vector<bool>&               hashed,          // [in] The content hash of the original ID is known
+    bool                                   skipIds,
+    SpvHasher*                             pHasher)         // [in,out] Hash to update
+{
+    size_t idIndex = instruction.idBegin;
+    for (size_t i = instruction.offset; i < instruction.offset + instruction.wordCount; ++i)
+    {
+        const uint32_t word = module.words[i];
+        if ((idIndex < instruction.idEnd) && (module.idOffsets[idIndex] == i))
+        {
+            ++idIndex;
+            if ((skipIds == false) && (word != instruction.resultId))
+            {
+                // A forward reference, e.g. of OpTypeForwardPointer, only adds a placeholder
+                pHasher->Update(((word < hashed.size()) && hashed[word]) ? contentHashes[word] : SpvHash128());
+            }
+        }
+        else
+        {
+            pHasher->Update(word);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Sort the declarations of the global part in a canonical order: by the hash of their content, which covers the
+// declarations they reference and the annotations of their result IDs, and then by the first use of their result IDs
+// in the functions. The original order only decides between declarations which nothing tells apart.
+static void SortDeclarations(
+    const SpvCanonicalModule&                      module,
+    size_t                                         functionsBegin,   // Index of the first instruction of the functions
+    std::vector<SpvCanonicalModule::Declaration>*  pDeclarations)    // [in,out] Declarations in their original order
+{
+    // Annotations of each ID, without their target
+    std::vector<std::vector<SpvHash128>> annotationHashes(module.idMap.size());
+    for (const SpvCanonicalModule::Instruction& instruction : module.instructions)
+    {
+        if (IsAnnotationInstruction(instruction.opcode) && (instruction.idEnd > instruction.idBegin))
+        {
+            const uint32_t target = module.words[module.idOffsets[instruction.idBegin]];
+            if (target < annotationHashes.size())
+            {
+                SpvHasher hasher;
+                HashInstructionContent(module, instruction, {}, {}, true, &hasher);
+                annotationHashes[target].push_back(hasher.Finalize());
+            }
+        }
+    }
+
+    // Definitions precede their uses in the global part, so the content hashes are built in the original order
+    std::vector<SpvHash128> contentHashes(module.idMap.size());
+    std::vector<bool> hashed(module.idMap.size(), false);
+    for (SpvCanonicalModule::Declaration& declaration : *pDeclarations)
+    {
+        SpvHasher hasher;
+        for (size_t i = 0; i < declaration.instructionCount; ++i)
+        {
+            const SpvCanonicalModule::Instruction& instruction =
+                module.instructions[declaration.firstInstruction + i];
+            HashInstructionContent(module, instruction, contentHashes, hashed, false, &hasher);
+        }
+
+        const uint32_t resultId = module.instructions[declaration.firstInstruction + declaration.instructionCount - 1].
+                                  resultId;
+        std::vector<SpvHash128>& annotations = annotationHashes[resultId];
+        std::sort(annotations.begin(), annotations.end(), CompareHashes);
+        hasher.Update(static_cast<uint64_t>(annotations.size()));
+        for (const SpvHash128& annotation : annotations)
+        {
+            hasher.Update(annotation);
+        }
+
+        declaration.contentHash = hasher.Finalize();
+        contentHashes[resultId] = declaration.contentHash;
+        hashed[resultId] = true;
+    }
+
+    // Position of the first reference of each ID by a function
+    std::vector<size_t> firstUses(module.idMap.size(), UnusedPosition);
+    size_t position = 0;
+    for (size_t i = functionsBegin; i < module.instructions.size(); ++i)
+    {
+        const SpvCanonicalModule::Instruction& instruction = module.instructions[i];
+        for (size_t idIndex = instruction.idBegin; idIndex < instruction.idEnd; ++idIndex)
+        {
+            const uint32_t id = module.words[module.idOffsets[idIndex]];
+            if ((id < firstUses.size()) && (firstUses[id] == UnusedPosition))
+            {
+                firstUses[id] = position;
+            }
+            ++position;
+        }
+    }
+
+    for (SpvCanonicalModule::Declaration& declaration : *pDeclarations)
+    {
+        declaration.firstUse =
+            firstUses[module.instructions[declaration.firstInstruction + declaration.instructionCount - 1].resultId];
+    }
+
+    std::stable_sort(pDeclarations->begin(),
+                     pDeclarations->end(),
+                     [](const SpvCanonicalModule::Declaration& left, const SpvCanonicalModule::Declaration& right)
+                     {
+                         if ((left.contentHash.hi != right.contentHash.hi) ||
+                             (left.contentHash.lo != right.contentHash.lo))
+                         {
+                             return CompareHashes(left.contentHash, right.contentHash);
+                         }
+                         return left.firstUse < right.firstUse;
+                     });
+}
+
+// =====================================================================================================================
+// Compute the canonical fingerprint of a SPIR-V module
+spv_result_t FingerprintSpirv(
+    spv_const_context context,           // [in] SPIRV-Tools context of the target environment of the module
+    const uint32_t*   pCode,             // [in] SPIR-V binary
+    size_t            wordCount,         // Number of words of the binary
+    bool              ignoreDebugInfo,   // Drop debug instructions from the canonical view
+    SpvHash128*       pFingerprint,      // [out] Fingerprint
+    spv_diagnostic*   pDiagnostic)       // [out] Diagnostic of an invalid binary
+{
+    SpvCanonicalModule module = {};
+    module.ignoreDebugInfo = ignoreDebugInfo;
+    module.words.reserve(wordCount);
+
+    spv_result_t result =
+        spvBinaryParse(context, &module, pCode, wordCount, RecordHeader, RecordInstruction, pDiagnostic);
+    if (result != SPV_SUCCESS)
+    {
+        return result;
+    }
+
+    // Split the ordered instructions of the global part into declarations, each with the OpLine and OpNoLine in front
+    // of it, and the remaining instructions, e.g. OpMemoryModel, which stay in place
+    size_t functionsBegin = module.instructions.size();
+    std::vector<SpvCanonicalModule::Declaration> declarations;
+    std::vector<size_t> globalInstructions;
+    size_t lineCount = 0;
+    for (size_t i = 0; i < module.instructions.size(); ++i)
+    {
+        const SpvCanonicalModule::Instruction& instruction = module.instructions[i];
+        if (instruction.opcode == OpFunction)
+        {
+            functionsBegin = i;
+            break;
+        }
+
+        if (instruction.unordered)
+        {
+            continue;
+        }
+
+        if (instruction.resultId != 0)
+        {
+            declarations.push_back({ i - lineCount, lineCount + 1, SpvHash128(), UnusedPosition });
+            lineCount = 0;
+        }
+        else if ((instruction.opcode == OpLine) || (instruction.opcode == OpNoLine))
+        {
+            ++lineCount;
+        }
+        else
+        {
+            for (size_t j = i - lineCount; j <= i; ++j)
+            {
+                globalInstructions.push_back(j);
+            }
+            lineCount = 0;
+        }
+    }
+    for (size_t j = functionsBegin - lineCount; j < functionsBegin; ++j)
+    {
+        globalInstructions.push_back(j);
+    }
+
+    // Number the declarations in canonical order, and the IDs of the functions in the order of their definitions
+    SortDeclarations(module, functionsBegin, &declarations);
+    uint32_t nextId = 1;
+    for (const SpvCanonicalModule::Declaration& declaration : declarations)
+    {
+        const uint32_t resultId =
+            module.instructions[declaration.firstInstruction + declaration.instructionCount - 1].resultId;
+        if (module.idMap[resultId] == 0)
+        {
+            module.idMap[resultId] = nextId++;
+        }
+    }
+    for (const SpvCanonicalModule::Instruction& instruction : module.instructions)
+    {
+        if ((instruction.resultId != 0) && (module.idMap[instruction.resultId] == 0))
+        {
+            module.idMap[instruction.resultId] = nextId++;
+        }
+    }
+
+    // Forward references are only resolved now
+    for (size_t offset : module.idOffsets)
+    {
+        const uint32_t id = module.words[offset];
+        module.words[offset] = ((id < module.idMap.size()) && (module.idMap[id] != 0)) ? module.idMap[id] : UndefinedId;
+    }
+
+    // The remaining instructions of the global part, the declarations in canonical order and the functions go to the
+    // hash in place, unordered ones are hashed one by one and added as a sorted set
+    SpvHasher hasher;
+    hasher.Update(module.version);
+    auto hashInstruction = [&module, &hasher](size_t index)
+        {
+            const SpvCanonicalModule::Instruction& instruction = module.instructions[index];
+            hasher.Update(module.words.data() + instruction.offset, instruction.wordCount * sizeof(uint32_t));
+        };
+    for (size_t index : globalInstructions)
+    {
+        hashInstruction(index);
+    }
+    for (const SpvCanonicalModule::Declaration& declaration : declarations)
+    {
+        for (size_t i = 0; i < declaration.instructionCount; ++i)
+        {
+            hashInstruction(declaration.firstInstruction + i);
+        }
+    }
+    for (size_t i = functionsBegin; i < module.instructions.size(); ++i)
+    {
+        if (module.instructions[i].unordered == false)
+        {
+            hashInstruction(i);
+        }
+    }
+
+    std::vector<SpvHash128> unorderedHashes;
+    for (const SpvCanonicalModule::Instruction& instruction : module.instructions)
+    {
+        if (instruction.unordered)
+        {
+            SpvHasher instructionHasher;
+            const uint32_t* pWords = module.words.data() + instruction.offset;
+            instructionHasher.Update(pWords, instruction.wordCount * sizeof(uint32_t));
+            unorderedHashes.push_back(instructionHasher.Finalize());
+        }
+    }
+
+    std::sort(unorderedHashes.begin(), unorderedHashes.end(), CompareHashes);
+    hasher.Update(static_cast<uint64_t>(unorderedHashes.size()));
+    for (const SpvHash128& unorderedHash : unorderedHashes)
+    {
+        hasher.Update(unorderedHash);
+    }
+
+    *pFingerprint = hasher.Finalize();
+    return SPV_SUCCESS;
+}
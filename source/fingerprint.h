@@ -0,0 +1,59 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  fingerprint.h
+* @brief SPVGEN header file: contains the declaration of the canonical SPIR-V module fingerprint.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "spirv-tools/libspirv.h"
+#include "hasher.h"
+
+// =====================================================================================================================
+// Compute a 128-bit hash of a canonical view of a SPIR-V module, so that modules which only differ in ways that don't
+// change their meaning get the same hash:
+//
+// - Capabilities, extensions, entry-points, execution modes, debug names and annotations are hashed regardless of their
+//   order.
+// - The declarations in front of the first function (types, constants, global variables, ...) are put in a canonical
+//   order: by a hash of their content, which covers the declarations they reference and their annotations, and then
+//   by the first use of their IDs in the functions. Functions stay in order.
+// - IDs are renumbered in that order, the ID bound and the generator of the header are ignored.
+// - If ignoreDebugInfo is set, debug instructions (OpSource*, OpName, OpMemberName, OpString, OpLine, OpNoLine,
+//   OpModuleProcessed) and the extended instructions of non-semantic and debug info sets are dropped.
+//
+// NOTE: The hash is stable across runs, but isn't a cryptographic hash.
+spv_result_t FingerprintSpirv(
+    spv_const_context context,
+    const uint32_t*   pCode,
+    size_t            wordCount,
+    bool              ignoreDebugInfo,
+    SpvHash128*       pFingerprint,
+    spv_diagnostic*   pDiagnostic);
@@ -0,0 +1,169 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  hasher.cpp
+* @brief SPVGEN source file: contains the implementation of the 128-bit content hasher.
+***********************************************************************************************************************
+*/
+#include "hasher.h"
+
+static const uint64_t C1 = 0x87c37b91114253d5ull;
+static const uint64_t C2 = 0x4cf5ad432745937full;
+
+// =====================================================================================================================
+static inline uint64_t Rotl64(
+    uint64_t value,
+    int      shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+// =====================================================================================================================
+// Final avalanche of MurmurHash3
+static inline uint64_t FMix64(
+    uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+// =====================================================================================================================
+// Load a little-endian 64-bit value from unaligned memory
+static inline uint64_t Load64(
+    const uint8_t* pData)
+{
+    uint64_t value;
+    memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+// =====================================================================================================================
+SpvHasher::SpvHasher(
+    uint64_t seed)  // Hash seed
+    :
+    h1(seed),
+    h2(seed),
+    totalSize(0),
+    tailSize(0)
+{
+}
+
+// =====================================================================================================================
+// Mix one 16-byte block into the hash state
+void SpvHasher::ProcessBlock(
+    const uint8_t* pBlock)  // [in] 16 bytes to hash
+{
+    uint64_t k1 = Load64(pBlock);
+    uint64_t k2 = Load64(pBlock + 8);
+
+    k1 *= C1; k1 = Rotl64(k1, 31); k1 *= C2; h1 ^= k1;
+    h1 = Rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+    k2 *= C2; k2 = Rotl64(k2, 33); k2 *= C1; h2 ^= k2;
+    h2 = Rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+}
+
+// =====================================================================================================================
+// Add a byte range to the hash
+void SpvHasher::Update(
+    const void* pData,  // [in] Data to hash
+    size_t      size)   // Size of the data in bytes
+{
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    totalSize += size;
+
+    // Complete the pending partial block first
+    if (tailSize > 0)
+    {
+        size_t copySize = sizeof(tail) - tailSize;
+        if (copySize > size)
+        {
+            copySize = size;
+        }
+        memcpy(tail + tailSize, pBytes, copySize);
+        tailSize += static_cast<uint32_t>(copySize);
+        pBytes += copySize;
+        size -= copySize;
+
+        if (tailSize < sizeof(tail))
+        {
+            return;
+        }
+        ProcessBlock(tail);
+        tailSize = 0;
+    }
+
+    while (size >= sizeof(tail))
+    {
+        ProcessBlock(pBytes);
+        pBytes += sizeof(tail);
+        size -= sizeof(tail);
+    }
+
+    if (size > 0)
+    {
+        memcpy(tail, pBytes, size);
+        tailSize = static_cast<uint32_t>(size);
+    }
+}
+
+// =====================================================================================================================
+// Get the hash of all the data added so far
+SpvHash128 SpvHasher::Finalize() const
+{
+    uint64_t f1 = h1;
+    uint64_t f2 = h2;
+
+    if (tailSize > 0)
+    {
+        uint8_t block[16] = {};
+        memcpy(block, tail, tailSize);
+        uint64_t k1 = Load64(block);
+        uint64_t k2 = Load64(block + 8);
+
+        k2 *= C2; k2 = Rotl64(k2, 33); k2 *= C1; f2 ^= k2;
+        k1 *= C1; k1 = Rotl64(k1, 31); k1 *= C2; f1 ^= k1;
+    }
+
+    f1 ^= totalSize;
+    f2 ^= totalSize;
+
+    f1 += f2;
+    f2 += f1;
+
+    f1 = FMix64(f1);
+    f2 = FMix64(f2);
+
+    f1 += f2;
+    f2 += f1;
+
+    SpvHash128 hash = { f1, f2 };
+    return hash;
+}
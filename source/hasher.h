@@ -0,0 +1,96 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  hasher.h
+* @brief SPVGEN header file: contains the declaration of the 128-bit content hasher.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// =====================================================================================================================
+// Represents a 128-bit hash value
+struct SpvHash128
+{
+    uint64_t lo;
+    uint64_t hi;
+
+    bool operator==(const SpvHash128& other) const { return (lo == other.lo) && (hi == other.hi); }
+    bool operator!=(const SpvHash128& other) const { return (*this == other) == false; }
+};
+
+// Functor to use SpvHash128 as the key of unordered containers
+struct SpvHash128Hasher
+{
+    size_t operator()(const SpvHash128& hash) const { return static_cast<size_t>(hash.lo ^ hash.hi); }
+};
+
+// =====================================================================================================================
+// Incremental 128-bit hasher, based on MurmurHash3 x64 128 (public domain, Austin Appleby).
+//
+// NOTE: The result only depends on the byte stream, not on how it is split into Update() calls. It is not a
+// cryptographic hash.
+class SpvHasher
+{
+public:
+    SpvHasher(uint64_t seed = 0);
+
+    // Add a byte range to the hash
+    void Update(const void* pData, size_t size);
+
+    // Add a string to the hash, its length is hashed as well so that adjacent strings don't alias
+    void UpdateString(const char* pString)
+    {
+        size_t length = (pString != nullptr) ? strlen(pString) : SIZE_MAX;
+        Update(length);
+        if (pString != nullptr)
+        {
+            Update(pString, length);
+        }
+    }
+
+    // Add the bytes of a plain value to the hash
+    template<typename T>
+    void Update(const T& value)
+    {
+        Update(&value, sizeof(value));
+    }
+
+    // Get the hash of all the data added so far
+    SpvHash128 Finalize() const;
+
+private:
+    void ProcessBlock(const uint8_t* pBlock);
+
+    uint64_t h1;
+    uint64_t h2;
+    uint64_t totalSize;
+    uint8_t  tail[16];
+    uint32_t tailSize;
+};
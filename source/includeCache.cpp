@@ -0,0 +1,163 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  includeCache.cpp
+* @brief SPVGEN source file: contains the implementation of the process-wide include file cache.
+***********************************************************************************************************************
+*/
+#include "includeCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// =====================================================================================================================
+// Get the modification time and the size of a file, returns false if the file doesn't exist
+static bool GetFileStat(
+    const std::string& path,            // File path
+    int64_t*           pModifyTime,     // [out] Modification time
+    uint64_t*          pSize)           // [out] File size in bytes
+{
+#if defined(_WIN32)
+    struct _stat64 fileStat = {};
+    if ((_stat64(path.c_str(), &fileStat) != 0) || ((fileStat.st_mode & _S_IFREG) == 0))
+    {
+        return false;
+    }
+    *pModifyTime = static_cast<int64_t>(fileStat.st_mtime);
+#else
+    struct stat fileStat = {};
+    if ((stat(path.c_str(), &fileStat) != 0) || (S_ISREG(fileStat.st_mode) == false))
+    {
+        return false;
+    }
+#if defined(__APPLE__)
+    *pModifyTime = static_cast<int64_t>(fileStat.st_mtimespec.tv_sec) * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+#else
+    *pModifyTime = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+#endif
+#endif
+    *pSize = static_cast<uint64_t>(fileStat.st_size);
+    return true;
+}
+
+// =====================================================================================================================
+// Get the process-wide include cache
+SpvIncludeCache* SpvIncludeCache::GetInstance()
+{
+    static SpvIncludeCache includeCache;
+    return &includeCache;
+}
+
+// =====================================================================================================================
+// Get the content of the specified file, returns null if the file can't be read
+std::shared_ptr<const SpvIncludeFile> SpvIncludeCache::GetFile(
+    const std::string& path)    // Resolved file path
+{
+    int64_t modifyTime = 0;
+    uint64_t size = 0;
+    if (GetFileStat(path, &modifyTime, &size) == false)
+    {
+        return nullptr;
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        auto it = files.find(path);
+        if ((it != files.end()) && (it->second->modifyTime == modifyTime) && (it->second->size == size))
+        {
+            return it->second;
+        }
+    }
+
+    // Read the file outside of the lock, concurrent misses of the same file read it twice but stay consistent
+    std::ifstream file(path, std::ios_base::binary);
+    if (file.good() == false)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<SpvIncludeFile> pFile = std::make_shared<SpvIncludeFile>();
+    pFile->data.resize(static_cast<size_t>(size));
+    file.read(&pFile->data[0], static_cast<std::streamsize>(size));
+    pFile->data.resize(static_cast<size_t>(file.gcount()));
+    pFile->modifyTime = modifyTime;
+    pFile->size = size;
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+    files[path] = pFile;
+    return pFile;
+}
+
+// =====================================================================================================================
+// Resolve a local include against the include directory stack, same as DirStackFileIncluder, but read the file through
+// the include cache
+glslang::TShader::Includer::IncludeResult* SpvCachedFileIncluder::readLocalPath(
+    const char* pHeaderName,    // [in] Name in the #include directive
+    const char* pIncluderName,  // [in] Name of the including file
+    int         depth)          // Include depth, 1 for includes of the shader source
+{
+    // Discard popped include directories, and initialize when at parse-time first level.
+    directoryStack.resize(depth + externalLocalDirectoryCount);
+    if (depth == 1)
+    {
+        directoryStack.back() = getDirectory(pIncluderName);
+    }
+
+    // Find a directory that works, using a reverse search of the include stack.
+    for (auto it = directoryStack.rbegin(); it != directoryStack.rend(); ++it)
+    {
+        std::string path = *it + '/' + pHeaderName;
+        std::replace(path.begin(), path.end(), '\\', '/');
+
+        std::shared_ptr<const SpvIncludeFile> pFile = SpvIncludeCache::GetInstance()->GetFile(path);
+        if (pFile != nullptr)
+        {
+            directoryStack.push_back(getDirectory(path));
+            ++includeCount;
+
+            // The result holds a reference of the cached file until it is released
+            auto pFileRef = new std::shared_ptr<const SpvIncludeFile>(std::move(pFile));
+            return new IncludeResult(path, (*pFileRef)->data.data(), (*pFileRef)->data.size(), pFileRef);
+        }
+    }
+
+    return nullptr;
+}
+
+// =====================================================================================================================
+// Release an include result returned by readLocalPath
+void SpvCachedFileIncluder::releaseInclude(
+    IncludeResult* pResult) // [in] Include result to release
+{
+    if (pResult != nullptr)
+    {
+        delete static_cast<std::shared_ptr<const SpvIncludeFile>*>(pResult->userData);
+        delete pResult;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  includeCache.h
+* @brief SPVGEN header file: contains the declaration of the process-wide include file cache.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include "glslang/Public/ShaderLang.h"
+#include "StandAlone/DirStackFileIncluder.h"
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+// =====================================================================================================================
+// Represents the content of an include file which is shared by all compiles
+struct SpvIncludeFile
+{
+    std::string data;       // File content
+    int64_t     modifyTime; // Modification time of the file when it was read
+    uint64_t    size;       // Size of the file when it was read
+};
+
+// =====================================================================================================================
+// Process-wide cache of include files, keyed by the resolved path and validated against the modification time and the
+// size of the file on every lookup.
+//
+// NOTE: Cached files are immutable and shared read-only, a file which changed on disk is read again and replaces the
+// entry while compiles still using the old content keep it alive.
+class SpvIncludeCache
+{
+public:
+    // Get the content of the specified file, returns null if the file can't be read
+    std::shared_ptr<const SpvIncludeFile> GetFile(const std::string& path);
+
+    // Get the process-wide include cache
+    static SpvIncludeCache* GetInstance();
+
+private:
+    std::shared_mutex                                                       lock;
+    std::unordered_map<std::string, std::shared_ptr<const SpvIncludeFile>>  files;
+};
+
+// =====================================================================================================================
+// DirStackFileIncluder which reads include files through the process-wide include cache.
+class SpvCachedFileIncluder : public DirStackFileIncluder
+{
+public:
+    virtual void releaseInclude(IncludeResult* pResult) override;
+
+    // Get the number of include directives resolved by this includer
+    uint32_t GetIncludeCount() const { return includeCount; }
+
+protected:
+    virtual IncludeResult* readLocalPath(const char* pHeaderName, const char* pIncluderName, int depth) override;
+
+private:
+    uint32_t includeCount = 0;
+};
@@ -0,0 +1,187 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  mappedFile.cpp
+* @brief SPVGEN source file: contains the implementation of the read-only/read-write memory-mapped file wrapper.
+***********************************************************************************************************************
+*/
+#include "mappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =====================================================================================================================
+SpvMappedFile::SpvMappedFile()
+    :
+    pData(nullptr),
+    size(0),
+    writable(false),
+    isOpen(false),
+#if defined(_WIN32)
+    hFile(INVALID_HANDLE_VALUE),
+    hMapping(nullptr)
+#else
+    fd(-1)
+#endif
+{
+}
+
+// =====================================================================================================================
+// Map an existing file, the mapping is shared with other processes if it is writable
+//
+// NOTE: An empty file is opened successfully, but GetData() returns null for it.
+bool SpvMappedFile::Open(
+    const char* pFileName,  // [in] Name of the file to map
+    bool        isWritable) // Whether the mapping is writable
+{
+    Close();
+    writable = isWritable;
+
+#if defined(_WIN32)
+    hFile = CreateFileA(pFileName,
+                        writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                        nullptr,
+                        OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL,
+                        nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (GetFileSizeEx(hFile, &fileSize) == FALSE)
+    {
+        Close();
+        return false;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+
+    if (size > 0)
+    {
+        hMapping = CreateFileMappingA(hFile, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        if (hMapping == nullptr)
+        {
+            Close();
+            return false;
+        }
+        pData = MapViewOfFile(hMapping, writable ? (FILE_MAP_READ | FILE_MAP_WRITE) : FILE_MAP_READ, 0, 0, 0);
+        if (pData == nullptr)
+        {
+            Close();
+            return false;
+        }
+    }
+#else
+    fd = open(pFileName, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0)
+    {
+        Close();
+        return false;
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+
+    if (size > 0)
+    {
+        void* pMapping = mmap(nullptr, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        if (pMapping == MAP_FAILED)
+        {
+            Close();
+            return false;
+        }
+        pData = pMapping;
+    }
+#endif
+
+    isOpen = true;
+    return true;
+}
+
+// =====================================================================================================================
+// Unmap the file
+void SpvMappedFile::Close()
+{
+#if defined(_WIN32)
+    if (pData != nullptr)
+    {
+        UnmapViewOfFile(pData);
+    }
+    if (hMapping != nullptr)
+    {
+        CloseHandle(hMapping);
+        hMapping = nullptr;
+    }
+    if (hFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(hFile);
+        hFile = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (pData != nullptr)
+    {
+        munmap(pData, size);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+#endif
+
+    pData = nullptr;
+    size = 0;
+    isOpen = false;
+}
+
+// =====================================================================================================================
+// Write the modified pages of a writable mapping back to the file
+bool SpvMappedFile::Flush()
+{
+    if ((writable == false) || (pData == nullptr))
+    {
+        return true;
+    }
+
+#if defined(_WIN32)
+    return FlushViewOfFile(pData, 0) != FALSE;
+#else
+    return msync(pData, size, MS_SYNC) == 0;
+#endif
+}
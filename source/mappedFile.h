@@ -0,0 +1,71 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  mappedFile.h
+* @brief SPVGEN header file: contains the declaration of the read-only/read-write memory-mapped file wrapper.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <cstddef>
+
+// =====================================================================================================================
+// Represents a whole file mapped into memory.
+class SpvMappedFile
+{
+public:
+    SpvMappedFile();
+    ~SpvMappedFile() { Close(); }
+
+    SpvMappedFile(const SpvMappedFile&) = delete;
+    SpvMappedFile& operator=(const SpvMappedFile&) = delete;
+
+    // Map an existing file, the mapping is shared with other processes if it is writable
+    bool Open(const char* pFileName, bool isWritable);
+
+    // Unmap the file
+    void Close();
+
+    // Write the modified pages of a writable mapping back to the file
+    bool Flush();
+
+    bool IsOpen() const { return isOpen; }
+    const void* GetData() const { return pData; }
+    void* GetWritableData() { return writable ? pData : nullptr; }
+    size_t GetSize() const { return size; }
+
+private:
+    void*  pData;
+    size_t size;
+    bool   writable;
+    bool   isOpen;
+#if defined(_WIN32)
+    void*  hFile;       // Windows file HANDLE
+    void*  hMapping;    // Windows file mapping HANDLE
+#else
+    int    fd;
+#endif
+};
@@ -0,0 +1,306 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  memoryHooks.cpp
+* @brief SPVGEN source file: contains the global allocation functions which report to the memory trackers.
+*
+* This file is only built into the shared library. The replaced allocation functions are not exported from it (see
+* memoryHooks.map), so they are used by glslang, SPIRV-Tools and SPIRV-Cross inside the library but never by the host
+* process. The static library leaves the allocation functions of the host alone, and only accounts the output buffers.
+***********************************************************************************************************************
+*/
+#include "memoryTracker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#define SPVGEN_USABLE_SIZE(pMemory) _msize(pMemory)
+#define SPVGEN_ALIGNED_USABLE_SIZE(pMemory, alignment) _aligned_msize(pMemory, alignment, 0)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define SPVGEN_USABLE_SIZE(pMemory) malloc_size(pMemory)
+#define SPVGEN_ALIGNED_USABLE_SIZE(pMemory, alignment) ((void)(alignment), malloc_size(pMemory))
+#else
+#include <malloc.h>
+#define SPVGEN_USABLE_SIZE(pMemory) malloc_usable_size(pMemory)
+#define SPVGEN_ALIGNED_USABLE_SIZE(pMemory, alignment) ((void)(alignment), malloc_usable_size(pMemory))
+#endif
+
+static const bool AllocationHooksInstalled = SpvMemoryTracker::InstallAllocationHooks();
+
+// =====================================================================================================================
+// Allocate memory and account it to the tracker of the calling thread, returns null only if the heap is exhausted.
+//
+// NOTE: The memory budget never makes an allocation fail, see SpvMemoryTracker.
+static void* TrackedAllocate(
+    size_t size)   // Size of the allocation in bytes
+{
+    void* pMemory = malloc((size != 0) ? size : 1);
+    SpvMemoryTracker* pTracker = SpvMemoryTracker::GetCurrent();
+    if ((pMemory != nullptr) && (pTracker != nullptr))
+    {
+        pTracker->TrackAllocation(pMemory, SPVGEN_USABLE_SIZE(pMemory));
+    }
+    return pMemory;
+}
+
+// =====================================================================================================================
+// Release memory and account it to the tracker of the calling thread, if that tracker accounted its allocation. The
+// memory may also come from the C++ runtime's own allocation functions, which aren't replaced inside the runtime.
+static void TrackedFree(
+    void* pMemory)   // [in] Memory to release, may be null
+{
+    if (pMemory != nullptr)
+    {
+        SpvMemoryTracker* pTracker = SpvMemoryTracker::GetCurrent();
+        if (pTracker != nullptr)
+        {
+            pTracker->UntrackAllocation(pMemory);
+        }
+        free(pMemory);
+    }
+}
+
+// =====================================================================================================================
+// Allocate over-aligned memory and account it to the tracker of the calling thread, returns null only if the heap is
+// exhausted
+static void* TrackedAlignedAllocate(
+    size_t           size,        // Size of the allocation in bytes
+    std::align_val_t alignment)   // Alignment of the allocation, a power of two
+{
+    const size_t align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+#if defined(_WIN32)
+    void* pMemory = _aligned_malloc((size != 0) ? size : 1, align);
+#else
+    void* pMemory = nullptr;
+    if (posix_memalign(&pMemory, align, (size != 0) ? size : 1) != 0)
+    {
+        pMemory = nullptr;
+    }
+#endif
+    SpvMemoryTracker* pTracker = SpvMemoryTracker::GetCurrent();
+    if ((pMemory != nullptr) && (pTracker != nullptr))
+    {
+        pTracker->TrackAllocation(pMemory, SPVGEN_ALIGNED_USABLE_SIZE(pMemory, align));
+    }
+    return pMemory;
+}
+
+// =====================================================================================================================
+// Release memory allocated by TrackedAlignedAllocate() and account it like TrackedFree()
+static void TrackedAlignedFree(
+    void* pMemory)   // [in] Memory to release, may be null
+{
+    if (pMemory != nullptr)
+    {
+        SpvMemoryTracker* pTracker = SpvMemoryTracker::GetCurrent();
+        if (pTracker != nullptr)
+        {
+            pTracker->UntrackAllocation(pMemory);
+        }
+#if defined(_WIN32)
+        _aligned_free(pMemory);
+#else
+        free(pMemory);
+#endif
+    }
+}
+
+// =====================================================================================================================
+void* operator new(
+    size_t size)
+{
+    void* pMemory = TrackedAllocate(size);
+    if (pMemory == nullptr)
+    {
+        // Only an exhausted heap gets here, the memory budget never fails an allocation
+        throw std::bad_alloc();
+    }
+    return pMemory;
+}
+
+// =====================================================================================================================
+void* operator new[](
+    size_t size)
+{
+    return ::operator new(size);
+}
+
+// =====================================================================================================================
+void* operator new(
+    size_t size,
+    const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size);
+}
+
+// =====================================================================================================================
+void* operator new[](
+    size_t size,
+    const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size);
+}
+
+// =====================================================================================================================
+void operator delete(
+    void* pMemory) noexcept
+{
+    TrackedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete[](
+    void* pMemory) noexcept
+{
+    TrackedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete(
+    void* pMemory,
+    size_t) noexcept
+{
+    TrackedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete[](
+    void* pMemory,
+    size_t) noexcept
+{
+    TrackedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete(
+    void* pMemory,
+    const std::nothrow_t&) noexcept
+{
+    TrackedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete[](
+    void* pMemory,
+    const std::nothrow_t&) noexcept
+{
+    TrackedFree(pMemory);
+}
+
+// =====================================================================================================================
+void* operator new(
+    size_t           size,
+    std::align_val_t alignment)
+{
+    void* pMemory = TrackedAlignedAllocate(size, alignment);
+    if (pMemory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pMemory;
+}
+
+// =====================================================================================================================
+void* operator new[](
+    size_t           size,
+    std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+// =====================================================================================================================
+void* operator new(
+    size_t           size,
+    std::align_val_t alignment,
+    const std::nothrow_t&) noexcept
+{
+    return TrackedAlignedAllocate(size, alignment);
+}
+
+// =====================================================================================================================
+void* operator new[](
+    size_t           size,
+    std::align_val_t alignment,
+    const std::nothrow_t&) noexcept
+{
+    return TrackedAlignedAllocate(size, alignment);
+}
+
+// =====================================================================================================================
+void operator delete(
+    void*            pMemory,
+    std::align_val_t) noexcept
+{
+    TrackedAlignedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete[](
+    void*            pMemory,
+    std::align_val_t) noexcept
+{
+    TrackedAlignedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete(
+    void*            pMemory,
+    size_t,
+    std::align_val_t) noexcept
+{
+    TrackedAlignedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete[](
+    void*            pMemory,
+    size_t,
+    std::align_val_t) noexcept
+{
+    TrackedAlignedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete(
+    void*            pMemory,
+    std::align_val_t,
+    const std::nothrow_t&) noexcept
+{
+    TrackedAlignedFree(pMemory);
+}
+
+// =====================================================================================================================
+void operator delete[](
+    void*            pMemory,
+    std::align_val_t,
+    const std::nothrow_t&) noexcept
+{
+    TrackedAlignedFree(pMemory);
+}
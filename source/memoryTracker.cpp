@@ -0,0 +1,169 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  memoryTracker.cpp
+* @brief SPVGEN source file: contains the implementation of the per-call memory accounting.
+***********************************************************************************************************************
+*/
+#include "memoryTracker.h"
+
+// Tracker of the current thread, it is a plain pointer so that the allocation hooks never run a TLS initializer
+static thread_local SpvMemoryTracker* pCurrentTracker = nullptr;
+static std::atomic<bool>              AllocationHooksInstalled(false);
+
+// =====================================================================================================================
+SpvMemoryTracker::SpvMemoryTracker(
+    uint64_t budget)   // Maximum number of bytes allocated at the same time, 0 means no budget
+    :
+    budget(budget),
+    currentBytes(0),
+    peakBytes(0),
+    totalBytes(0),
+    budgetExceeded(false)
+{
+}
+
+// =====================================================================================================================
+// Account an allocation, the budget is marked as exceeded if the allocated memory goes beyond it
+void SpvMemoryTracker::OnAllocate(
+    size_t size)   // Size of the allocation in bytes
+{
+    const int64_t current = (currentBytes += static_cast<int64_t>(size));
+    totalBytes += size;
+    if (current > 0)
+    {
+        uint64_t peak = peakBytes;
+        while ((static_cast<uint64_t>(current) > peak) &&
+               (peakBytes.compare_exchange_weak(peak, static_cast<uint64_t>(current)) == false))
+        {
+        }
+
+        if ((budget != 0) && (static_cast<uint64_t>(current) > budget))
+        {
+            budgetExceeded = true;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Account a release
+void SpvMemoryTracker::OnFree(
+    size_t size)   // Size of the released allocation in bytes
+{
+    currentBytes -= static_cast<int64_t>(size);
+}
+
+// =====================================================================================================================
+// Get the shard which holds an allocation
+SpvMemoryTracker::AllocationShard& SpvMemoryTracker::GetShard(
+    const void* pMemory)   // [in] Allocated memory
+{
+    // Heap blocks are at least 16-byte aligned, the low bits carry no information
+    const uintptr_t address = reinterpret_cast<uintptr_t>(pMemory) >> 4;
+    return shards[(address ^ (address >> 7)) % ShardCount];
+}
+
+// =====================================================================================================================
+// Account an allocation reported by the allocation hooks, and remember it for its release
+void SpvMemoryTracker::TrackAllocation(
+    const void* pMemory,   // [in] Allocated memory
+    size_t      size)      // Size of the allocation in bytes
+{
+    {
+        // The table allocates through the hooks too, its own memory isn't accounted
+        SpvMemoryScope untracked(nullptr);
+        AllocationShard& shard = GetShard(pMemory);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.allocations[pMemory] = size;
+    }
+    OnAllocate(size);
+}
+
+// =====================================================================================================================
+// Account the release of an allocation reported by the allocation hooks. Memory which wasn't reported to this tracker,
+// e.g. allocated before the call or by the C++ runtime, is ignored.
+void SpvMemoryTracker::UntrackAllocation(
+    const void* pMemory)   // [in] Released memory
+{
+    size_t size = 0;
+    {
+        SpvMemoryScope untracked(nullptr);
+        AllocationShard& shard = GetShard(pMemory);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto it = shard.allocations.find(pMemory);
+        if (it == shard.allocations.end())
+        {
+            return;
+        }
+        size = it->second;
+        shard.allocations.erase(it);
+    }
+    OnFree(size);
+}
+
+// =====================================================================================================================
+// Get the tracker of the calling thread, null if the thread isn't tracked
+SpvMemoryTracker* SpvMemoryTracker::GetCurrent()
+{
+    return pCurrentTracker;
+}
+
+// =====================================================================================================================
+// Returns true if the calling thread is tracked and the budget of its tracker is exceeded
+bool SpvMemoryTracker::IsCurrentBudgetExceeded()
+{
+    return (pCurrentTracker != nullptr) && pCurrentTracker->IsBudgetExceeded();
+}
+
+// =====================================================================================================================
+// Returns true if the global allocation functions of this module report to the trackers
+bool SpvMemoryTracker::HasAllocationHooks()
+{
+    return AllocationHooksInstalled;
+}
+
+// =====================================================================================================================
+// Called once by the allocation hooks when the module is loaded
+bool SpvMemoryTracker::InstallAllocationHooks()
+{
+    AllocationHooksInstalled = true;
+    return true;
+}
+
+// =====================================================================================================================
+SpvMemoryScope::SpvMemoryScope(
+    SpvMemoryTracker* pTracker)   // [in] Tracker of the scope, may be null
+    :
+    pPrevious(pCurrentTracker)
+{
+    pCurrentTracker = pTracker;
+}
+
+// =====================================================================================================================
+SpvMemoryScope::~SpvMemoryScope()
+{
+    pCurrentTracker = pPrevious;
+}
@@ -0,0 +1,121 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  memoryTracker.h
+* @brief SPVGEN header file: contains the declaration of the per-call memory accounting.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+// =====================================================================================================================
+// Accounts the heap memory allocated during one API call, and optionally enforces a budget on it.
+//
+// Allocations are reported by the allocation hooks of spvgen (see memoryHooks.cpp) and by the output buffer allocator
+// while the tracker is the current tracker of the allocating thread. Tasks submitted to the worker thread pool run
+// with the tracker of the submitting thread, so the work a call spreads over the pool is accounted to the call.
+//
+// The tracker remembers every allocation the hooks reported to it, and only accounts the release of those. Memory
+// allocated before the call, or by the C++ runtime's own out-of-line code which doesn't go through the hooks, is never
+// subtracted, so the current and the peak bytes never drop below what the call really holds.
+//
+// NOTE: The budget is only enforced between the phases of a call, it never makes an allocation fail. glslang and
+// SPIRV-Tools aren't built to unwind exceptions, so nothing may be thrown through their frames. The tracker only
+// records that the budget was exceeded, and the calls check it between their phases and tasks, where spvgen can stop
+// and fail cleanly.
+class SpvMemoryTracker
+{
+public:
+    explicit SpvMemoryTracker(uint64_t budget);
+
+    // Account an allocation
+    void OnAllocate(size_t size);
+
+    // Account a release
+    void OnFree(size_t size);
+
+    // Account an allocation reported by the allocation hooks, and remember it for its release
+    void TrackAllocation(const void* pMemory, size_t size);
+
+    // Account the release of an allocation reported by the allocation hooks, other memory is ignored
+    void UntrackAllocation(const void* pMemory);
+
+    uint64_t GetBudget() const { return budget; }
+    uint64_t GetPeakBytes() const { return peakBytes; }
+    uint64_t GetTotalBytes() const { return totalBytes; }
+    bool IsBudgetExceeded() const { return budgetExceeded; }
+
+    // Get the tracker of the calling thread, null if the thread isn't tracked
+    static SpvMemoryTracker* GetCurrent();
+
+    // Returns true if the calling thread is tracked and the budget of its tracker is exceeded
+    static bool IsCurrentBudgetExceeded();
+
+    // Returns true if the global allocation functions of this module report to the trackers
+    static bool HasAllocationHooks();
+
+    // Called once by the allocation hooks when the module is loaded
+    static bool InstallAllocationHooks();
+
+private:
+    static constexpr uint32_t ShardCount = 16;
+
+    // Part of the allocations reported by the hooks, sharded by address to keep the worker threads apart
+    struct AllocationShard
+    {
+        std::mutex                              lock;
+        std::unordered_map<const void*, size_t> allocations;   // Size of each allocation which isn't released yet
+    };
+
+    AllocationShard& GetShard(const void* pMemory);
+
+    const uint64_t        budget;           // 0 means no budget
+    std::atomic<int64_t>  currentBytes;     // Accounted bytes which aren't released yet
+    std::atomic<uint64_t> peakBytes;
+    std::atomic<uint64_t> totalBytes;
+    std::atomic<bool>     budgetExceeded;   // Stays set for the rest of the call
+    AllocationShard       shards[ShardCount];
+};
+
+// =====================================================================================================================
+// Makes a tracker the current tracker of the calling thread for its lifetime, a null tracker suspends the tracking.
+class SpvMemoryScope
+{
+public:
+    explicit SpvMemoryScope(SpvMemoryTracker* pTracker);
+    ~SpvMemoryScope();
+
+    SpvMemoryScope(const SpvMemoryScope&) = delete;
+    SpvMemoryScope& operator=(const SpvMemoryScope&) = delete;
+
+private:
+    SpvMemoryTracker* pPrevious;
+};
@@ -0,0 +1,811 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  reflect.cpp
+* @brief SPVGEN source file: contains the implementation of the resource reflection of SPIR-V modules.
+***********************************************************************************************************************
+*/
+#include "reflect.h"
+
+#include <algorithm>
+
+// Opcodes of the instructions the reflection reads, from the SPIR-V specification
+enum SpvReflectOpcode : uint16_t
+{
+    OpExecutionMode             = 16,
+    OpTypeBool                  = 20,
+    OpTypeInt                   = 21,
+    OpTypeFloat                 = 22,
+    OpTypeVector                = 23,
+    OpTypeMatrix                = 24,
+    OpTypeImage                 = 25,
+    OpTypeSampler               = 26,
+    OpTypeSampledImage          = 27,
+    OpTypeArray                 = 28,
+    OpTypeRuntimeArray          = 29,
+    OpTypeStruct                = 30,
+    OpTypePointer               = 32,
+    OpConstantTrue              = 41,
+    OpConstantFalse             = 42,
+    OpConstant                  = 43,
+    OpConstantComposite         = 44,
+    OpSpecConstantTrue          = 48,
+    OpSpecConstantFalse         = 49,
+    OpSpecConstant              = 50,
+    OpSpecConstantComposite     = 51,
+    OpFunction                  = 54,
+    OpVariable                  = 59,
+    OpDecorate                  = 71,
+    OpMemberDecorate            = 72,
+    OpExecutionModeId           = 331,
+    OpTypeAccelerationStructure = 5341,
+};
+
+// Decorations the reflection reads, from the SPIR-V specification
+enum SpvReflectDecoration : uint32_t
+{
+    DecorationSpecId        = 1,
+    DecorationBufferBlock   = 3,
+    DecorationRowMajor      = 4,
+    DecorationArrayStride   = 6,
+    DecorationMatrixStride  = 7,
+    DecorationBuiltIn       = 11,
+    DecorationLocation      = 30,
+    DecorationComponent     = 31,
+    DecorationBinding       = 33,
+    DecorationDescriptorSet = 34,
+    DecorationOffset        = 35,
+};
+
+// Storage classes the reflection reads, from the SPIR-V specification
+enum SpvReflectStorageClass : uint32_t
+{
+    StorageClassUniformConstant = 0,
+    StorageClassInput           = 1,
+    StorageClassUniform         = 2,
+    StorageClassPushConstant    = 9,
+    StorageClassStorageBuffer   = 12,
+};
+
+// Other enumerants the reflection reads, from the SPIR-V specification
+static const uint32_t DimBuffer                = 5;
+static const uint32_t DimSubpassData           = 6;
+static const uint32_t ImageSampledStorage      = 2;
+static const uint32_t ExecutionModeLocalSize   = 17;
+static const uint32_t ExecutionModeLocalSizeId = 38;
+static const uint32_t BuiltInWorkgroupSize     = 25;
+
+static const size_t   HeaderWordCount = 5;
+static const uint32_t MaxIdBound      = 0x400000;   // Universal limit of the SPIR-V specification
+static const uint32_t MaxTypeDepth    = 64;         // Deepest nesting of types which is followed
+static const uint32_t Unset           = UINT32_MAX;
+
+// Decorations of one ID
+struct IdDecorations
+{
+    uint32_t descriptorSet;
+    uint32_t binding;
+    uint32_t location;
+    uint32_t component;
+    uint32_t specId;
+    uint32_t builtIn;
+    uint32_t arrayStride;
+    bool     bufferBlock;
+};
+
+static const IdDecorations NoDecorations = { Unset, Unset, Unset, 0, Unset, Unset, Unset, false };
+
+// One decoration of a structure member
+struct MemberDecoration
+{
+    uint32_t structId;
+    uint32_t member;
+    uint32_t decoration;
+    uint32_t value;
+};
+
+// State of the pass over a module
+struct SpvReflectedModule
+{
+    const uint32_t*               pCode;
+    uint32_t                      idBound;
+    std::vector<uint32_t>         definitions;        // Offset of the defining instruction of each ID, 0 if none
+    std::vector<uint32_t>         decorationIndices;  // Index in decorations of each ID, Unset if it has none
+    std::vector<IdDecorations>    decorations;
+    std::vector<MemberDecoration> memberDecorations;  // Sorted by structure and member once the pass is finished
+    std::vector<uint32_t>         pushConstantTypes;  // Block type of each entry of SpvReflectionData::pushConstants
+    uint32_t                      localSizeIds[3];    // Constants of LocalSizeId, Unset if not declared
+    uint32_t                      workgroupSizeId;    // Constant decorated with BuiltIn WorkgroupSize, or Unset
+};
+
+// =====================================================================================================================
+// Get a word of an instruction, returns 0 if the instruction is too short
+static uint32_t GetWord(
+    const uint32_t* pInst,
+    uint32_t        index)
+{
+    return (index < (pInst[0] >> 16)) ? pInst[index] : 0;
+}
+
+// =====================================================================================================================
+// Get the defining instruction of an ID, returns null if the ID isn't defined before the first function
+static const uint32_t* GetDefinition(
+    const SpvReflectedModule& module,
+    uint32_t                  id)
+{
+    if ((id >= module.idBound) || (module.definitions[id] == 0))
+    {
+        return nullptr;
+    }
+    return module.pCode + module.definitions[id];
+}
+
+// =====================================================================================================================
+// Get the opcode of the defining instruction of an ID, returns 0 if the ID isn't defined
+static uint16_t GetDefinitionOpcode(
+    const SpvReflectedModule& module,
+    uint32_t                  id)
+{
+    const uint32_t* pInst = GetDefinition(module, id);
+    return (pInst != nullptr) ? static_cast<uint16_t>(pInst[0] & 0xFFFF) : 0;
+}
+
+// =====================================================================================================================
+// Get the decorations of an ID
+static const IdDecorations& GetDecorations(
+    const SpvReflectedModule& module,
+    uint32_t                  id)
+{
+    if ((id >= module.idBound) || (module.decorationIndices[id] == Unset))
+    {
+        return NoDecorations;
+    }
+    return module.decorations[module.decorationIndices[id]];
+}
+
+// =====================================================================================================================
+// Get the decorations of an ID to record a decoration, they are added on first use
+static IdDecorations* GetOrAddDecorations(
+    SpvReflectedModule* pModule,
+    uint32_t            id)        // Must be below the ID bound
+{
+    uint32_t& index = pModule->decorationIndices[id];
+    if (index == Unset)
+    {
+        index = static_cast<uint32_t>(pModule->decorations.size());
+        pModule->decorations.push_back(NoDecorations);
+    }
+    return &pModule->decorations[index];
+}
+
+// =====================================================================================================================
+static bool IsMemberBefore(
+    const MemberDecoration& left,
+    const MemberDecoration& right)
+{
+    return (left.structId < right.structId) || ((left.structId == right.structId) && (left.member < right.member));
+}
+
+// =====================================================================================================================
+// Get a decoration of a structure member, returns defaultValue if the member doesn't have it
+static uint32_t GetMemberDecoration(
+    const SpvReflectedModule& module,
+    uint32_t                  structId,
+    uint32_t                  member,
+    uint32_t                  decoration,
+    uint32_t                  defaultValue)
+{
+    const MemberDecoration key = { structId, member, 0, 0 };
+    auto it = std::lower_bound(module.memberDecorations.begin(), module.memberDecorations.end(), key, IsMemberBefore);
+    for (; (it != module.memberDecorations.end()) && (it->structId == structId) && (it->member == member); ++it)
+    {
+        if (it->decoration == decoration)
+        {
+            return it->value;
+        }
+    }
+    return defaultValue;
+}
+
+// =====================================================================================================================
+// Get the value of a scalar constant, or the default value of a scalar specialization constant. Returns false if the
+// ID isn't one.
+static bool GetConstantValue(
+    const SpvReflectedModule& module,
+    uint32_t                  id,
+    uint64_t*                 pValue)   // [out] Bits of the value
+{
+    const uint32_t* pInst = GetDefinition(module, id);
+    switch (GetDefinitionOpcode(module, id))
+    {
+    case OpConstantTrue:
+    case OpSpecConstantTrue:
+        *pValue = 1;
+        return true;
+    case OpConstantFalse:
+    case OpSpecConstantFalse:
+        *pValue = 0;
+        return true;
+    case OpConstant:
+    case OpSpecConstant:
+        *pValue = GetWord(pInst, 3) | (static_cast<uint64_t>(GetWord(pInst, 4)) << 32);
+        return true;
+    default:
+        return false;
+    }
+}
+
+// =====================================================================================================================
+// Get the base type and bit width of a scalar type, returns SpvReflectBaseTypeUnknown if the ID isn't one
+static SpvReflectBaseType GetBaseType(
+    const SpvReflectedModule& module,
+    uint32_t                  typeId,
+    uint32_t*                 pBitWidth)   // [out] Bit width of the type
+{
+    const uint32_t* pType = GetDefinition(module, typeId);
+    switch (GetDefinitionOpcode(module, typeId))
+    {
+    case OpTypeBool:
+        // Booleans are specialized and passed as 32-bit values
+        *pBitWidth = 32;
+        return SpvReflectBaseTypeBool;
+    case OpTypeInt:
+        *pBitWidth = GetWord(pType, 2);
+        return (GetWord(pType, 3) != 0) ? SpvReflectBaseTypeInt : SpvReflectBaseTypeUint;
+    case OpTypeFloat:
+        *pBitWidth = GetWord(pType, 2);
+        return SpvReflectBaseTypeFloat;
+    default:
+        *pBitWidth = 0;
+        return SpvReflectBaseTypeUnknown;
+    }
+}
+
+static uint32_t GetTypeSize(
+    const SpvReflectedModule& module, uint32_t typeId, uint32_t matrixStride, bool rowMajor, uint32_t depth);
+
+// =====================================================================================================================
+// Get the byte range covered by the members of a structure with explicit layout
+static void GetMemberRange(
+    const SpvReflectedModule& module,
+    uint32_t                  structId,
+    uint32_t                  depth,     // Nesting depth of the structure
+    uint32_t*                 pBegin,    // [out] Offset of the first member
+    uint32_t*                 pEnd)      // [out] End of the last member
+{
+    const uint32_t* pType = GetDefinition(module, structId);
+    const uint32_t memberCount = (pType[0] >> 16) - 2;
+
+    uint32_t begin = UINT32_MAX;
+    uint32_t end = 0;
+    for (uint32_t member = 0; member < memberCount; ++member)
+    {
+        const uint32_t offset = GetMemberDecoration(module, structId, member, DecorationOffset, 0);
+        const uint32_t matrixStride = GetMemberDecoration(module, structId, member, DecorationMatrixStride, 0);
+        const bool rowMajor = GetMemberDecoration(module, structId, member, DecorationRowMajor, 0) != 0;
+        begin = std::min(begin, offset);
+        end = std::max(end, offset + GetTypeSize(module, pType[2 + member], matrixStride, rowMajor, depth + 1));
+    }
+
+    *pBegin = (memberCount != 0) ? begin : 0;
+    *pEnd = end;
+}
+
+// =====================================================================================================================
+// Get the size of a type with explicit layout in bytes, the size of a structure ends with its last member
+static uint32_t GetTypeSize(
+    const SpvReflectedModule& module,
+    uint32_t                  typeId,
+    uint32_t                  matrixStride,   // Matrix stride of the enclosing member, 0 if it has none
+    bool                      rowMajor,       // Whether the enclosing member is decorated with RowMajor
+    uint32_t                  depth)          // Nesting depth of the type
+{
+    if (depth > MaxTypeDepth)
+    {
+        return 0;
+    }
+
+    const uint32_t* pType = GetDefinition(module, typeId);
+    switch (GetDefinitionOpcode(module, typeId))
+    {
+    case OpTypeBool:
+        return 4;
+    case OpTypeInt:
+    case OpTypeFloat:
+        return GetWord(pType, 2) / 8;
+    case OpTypeVector:
+        return GetWord(pType, 3) * GetTypeSize(module, GetWord(pType, 2), 0, false, depth + 1);
+    case OpTypeMatrix:
+        {
+            if (matrixStride == 0)
+            {
+                return GetWord(pType, 3) * GetTypeSize(module, GetWord(pType, 2), 0, false, depth + 1);
+            }
+
+            // The stride separates the columns of a column-major matrix and the rows of a row-major one, a row has
+            // one component per column vector component
+            const uint32_t* pColumnType = GetDefinition(module, GetWord(pType, 2));
+            const uint32_t strideCount =
+                (rowMajor && (pColumnType != nullptr)) ? GetWord(pColumnType, 3) : GetWord(pType, 3);
+            return strideCount * matrixStride;
+        }
+    case OpTypeArray:
+        {
+            uint64_t length = 0;
+            GetConstantValue(module, GetWord(pType, 3), &length);
+            const uint32_t arrayStride = GetDecorations(module, typeId).arrayStride;
+            const uint32_t elementSize = (arrayStride != Unset) ?
+                                         arrayStride :
+                                         GetTypeSize(module, GetWord(pType, 2), matrixStride, rowMajor, depth + 1);
+            return static_cast<uint32_t>(length) * elementSize;
+        }
+    case OpTypeStruct:
+        {
+            uint32_t begin = 0;
+            uint32_t end = 0;
+            GetMemberRange(module, typeId, depth, &begin, &end);
+            return end;
+        }
+    case OpTypePointer:
+        // Physical storage buffer pointer
+        return 8;
+    default:
+        // Runtime arrays don't add to the size
+        return 0;
+    }
+}
+
+// =====================================================================================================================
+// Find the descriptor type and the array size of a resource variable, returns false if it isn't a descriptor
+static bool GetDescriptorType(
+    const SpvReflectedModule&  module,
+    uint32_t                   storageClass,
+    uint32_t                   typeId,            // Type the variable points to
+    SpvReflectDescriptorType*  pDescriptorType,   // [out] Type of the descriptor
+    uint32_t*                  pCount)            // [out] Number of array elements, 0 for a runtime array
+{
+    uint32_t count = 1;
+    for (uint32_t depth = 0; depth < MaxTypeDepth; ++depth)
+    {
+        const uint16_t opcode = GetDefinitionOpcode(module, typeId);
+        const uint32_t* pType = GetDefinition(module, typeId);
+        if (opcode == OpTypeArray)
+        {
+            uint64_t length = 1;
+            GetConstantValue(module, GetWord(pType, 3), &length);
+            count *= static_cast<uint32_t>(length);
+        }
+        else if (opcode == OpTypeRuntimeArray)
+        {
+            count = 0;
+        }
+        else
+        {
+            break;
+        }
+        typeId = GetWord(pType, 2);
+    }
+    *pCount = count;
+
+    const uint32_t* pType = GetDefinition(module, typeId);
+    switch (GetDefinitionOpcode(module, typeId))
+    {
+    case OpTypeStruct:
+        if ((storageClass == StorageClassStorageBuffer) || GetDecorations(module, typeId).bufferBlock)
+        {
+            *pDescriptorType = SpvReflectDescriptorStorageBuffer;
+            return true;
+        }
+        *pDescriptorType = SpvReflectDescriptorUniformBuffer;
+        return (storageClass == StorageClassUniform);
+    case OpTypeSampler:
+        *pDescriptorType = SpvReflectDescriptorSampler;
+        return true;
+    case OpTypeSampledImage:
+        {
+            const uint32_t* pImage = GetDefinition(module, GetWord(pType, 2));
+            const bool isBuffer = (pImage != nullptr) && (GetWord(pImage, 3) == DimBuffer);
+            *pDescriptorType = isBuffer ? SpvReflectDescriptorUniformTexelBuffer :
+                                          SpvReflectDescriptorCombinedImageSampler;
+            return true;
+        }
+    case OpTypeImage:
+        {
+            const uint32_t dim = GetWord(pType, 3);
+            const bool isStorage = (GetWord(pType, 7) == ImageSampledStorage);
+            if (dim == DimBuffer)
+            {
+                *pDescriptorType = isStorage ? SpvReflectDescriptorStorageTexelBuffer :
+                                               SpvReflectDescriptorUniformTexelBuffer;
+            }
+            else if (dim == DimSubpassData)
+            {
+                *pDescriptorType = SpvReflectDescriptorInputAttachment;
+            }
+            else
+            {
+                *pDescriptorType = isStorage ? SpvReflectDescriptorStorageImage : SpvReflectDescriptorSampledImage;
+            }
+            return true;
+        }
+    case OpTypeAccelerationStructure:
+        *pDescriptorType = SpvReflectDescriptorAccelerationStructure;
+        return true;
+    default:
+        return false;
+    }
+}
+
+// =====================================================================================================================
+// Fill the type of a stage input, returns false if it isn't a scalar, a vector, a matrix or an array of them
+static bool GetInputType(
+    const SpvReflectedModule& module,
+    uint32_t                  typeId,   // Type the variable points to
+    SpvReflectInput*          pInput)   // [out] Input to fill
+{
+    pInput->arraySize = 1;
+    pInput->columnCount = 1;
+    pInput->vectorSize = 1;
+
+    for (uint32_t depth = 0; (depth < MaxTypeDepth) && (GetDefinitionOpcode(module, typeId) == OpTypeArray); ++depth)
+    {
+        const uint32_t* pType = GetDefinition(module, typeId);
+        uint64_t length = 1;
+        GetConstantValue(module, GetWord(pType, 3), &length);
+        pInput->arraySize *= static_cast<uint32_t>(length);
+        typeId = GetWord(pType, 2);
+    }
+
+    if (GetDefinitionOpcode(module, typeId) == OpTypeMatrix)
+    {
+        const uint32_t* pType = GetDefinition(module, typeId);
+        pInput->columnCount = GetWord(pType, 3);
+        typeId = GetWord(pType, 2);
+    }
+
+    if (GetDefinitionOpcode(module, typeId) == OpTypeVector)
+    {
+        const uint32_t* pType = GetDefinition(module, typeId);
+        pInput->vectorSize = GetWord(pType, 3);
+        typeId = GetWord(pType, 2);
+    }
+
+    pInput->baseType = GetBaseType(module, typeId, &pInput->bitWidth);
+    return (pInput->baseType != SpvReflectBaseTypeUnknown);
+}
+
+// =====================================================================================================================
+// Record a global variable which is a descriptor, a push constant block or a stage input
+static void ReflectVariable(
+    SpvReflectedModule* pModule,
+    const uint32_t*     pInst,   // [in] OpVariable instruction
+    SpvReflectionData*  pData)   // [in,out] Reflected resources
+{
+    const uint32_t id = GetWord(pInst, 2);
+    const uint32_t storageClass = GetWord(pInst, 3);
+    const uint32_t* pPointer = GetDefinition(*pModule, GetWord(pInst, 1));
+    if ((pPointer == nullptr) || ((pPointer[0] & 0xFFFF) != OpTypePointer))
+    {
+        return;
+    }
+    const uint32_t typeId = GetWord(pPointer, 3);
+    const IdDecorations& decorations = GetDecorations(*pModule, id);
+
+    switch (storageClass)
+    {
+    case StorageClassUniformConstant:
+    case StorageClassUniform:
+    case StorageClassStorageBuffer:
+        {
+            SpvReflectDescriptor descriptor = {};
+            if ((decorations.binding != Unset) &&
+                GetDescriptorType(*pModule, storageClass, typeId, &descriptor.descriptorType, &descriptor.count))
+            {
+                descriptor.id = id;
+                descriptor.set = (decorations.descriptorSet != Unset) ? decorations.descriptorSet : 0;
+                descriptor.binding = decorations.binding;
+                pData->descriptors.push_back(descriptor);
+            }
+            break;
+        }
+    case StorageClassPushConstant:
+        if (GetDefinitionOpcode(*pModule, typeId) == OpTypeStruct)
+        {
+            // The range is found once the member decorations are sorted
+            SpvReflectPushConstant pushConstant = {};
+            pushConstant.id = id;
+            pData->pushConstants.push_back(pushConstant);
+            pModule->pushConstantTypes.push_back(typeId);
+        }
+        break;
+    case StorageClassInput:
+        {
+            SpvReflectInput input = {};
+            if ((decorations.location != Unset) &&
+                (decorations.builtIn == Unset) &&
+                GetInputType(*pModule, typeId, &input))
+            {
+                input.id = id;
+                input.location = decorations.location;
+                input.component = decorations.component;
+                pData->inputs.push_back(input);
+            }
+            break;
+        }
+    default:
+        break;
+    }
+}
+
+// =====================================================================================================================
+// Record a scalar specialization constant if it has a spec ID
+static void ReflectSpecConstant(
+    const SpvReflectedModule& module,
+    const uint32_t*           pInst,   // [in] OpSpecConstant, OpSpecConstantTrue or OpSpecConstantFalse instruction
+    SpvReflectionData*        pData)   // [in,out] Reflected resources
+{
+    const uint32_t id = GetWord(pInst, 2);
+    const uint32_t specId = GetDecorations(module, id).specId;
+    if (specId == Unset)
+    {
+        return;
+    }
+
+    SpvReflectSpecConstant specConstant = {};
+    specConstant.id = id;
+    specConstant.specId = specId;
+    specConstant.baseType = GetBaseType(module, GetWord(pInst, 1), &specConstant.bitWidth);
+    GetConstantValue(module, id, &specConstant.defaultValue);
+    pData->specConstants.push_back(specConstant);
+}
+
+// =====================================================================================================================
+// Record a decoration of an ID
+static void RecordDecoration(
+    SpvReflectedModule* pModule,
+    const uint32_t*     pInst)   // [in] OpDecorate instruction
+{
+    const uint32_t id = pInst[1];
+    const uint32_t value = GetWord(pInst, 3);
+    switch (pInst[2])
+    {
+    case DecorationSpecId:
+        GetOrAddDecorations(pModule, id)->specId = value;
+        break;
+    case DecorationBufferBlock:
+        GetOrAddDecorations(pModule, id)->bufferBlock = true;
+        break;
+    case DecorationArrayStride:
+        GetOrAddDecorations(pModule, id)->arrayStride = value;
+        break;
+    case DecorationBuiltIn:
+        GetOrAddDecorations(pModule, id)->builtIn = value;
+        if (value == BuiltInWorkgroupSize)
+        {
+            pModule->workgroupSizeId = id;
+        }
+        break;
+    case DecorationLocation:
+        GetOrAddDecorations(pModule, id)->location = value;
+        break;
+    case DecorationComponent:
+        GetOrAddDecorations(pModule, id)->component = value;
+        break;
+    case DecorationBinding:
+        GetOrAddDecorations(pModule, id)->binding = value;
+        break;
+    case DecorationDescriptorSet:
+        GetOrAddDecorations(pModule, id)->descriptorSet = value;
+        break;
+    default:
+        break;
+    }
+}
+
+// =====================================================================================================================
+// Find the workgroup size and the spec IDs of its dimensions. The BuiltIn WorkgroupSize constant overrides the
+// execution mode.
+static void ReflectWorkgroupSize(
+    const SpvReflectedModule& module,
+    SpvReflectionData*        pData)   // [in,out] Reflected resources, holds the LocalSize literals if any
+{
+    uint32_t sizeIds[3] = { module.localSizeIds[0], module.localSizeIds[1], module.localSizeIds[2] };
+    const uint16_t compositeOpcode = GetDefinitionOpcode(module, module.workgroupSizeId);
+    if ((compositeOpcode == OpConstantComposite) || (compositeOpcode == OpSpecConstantComposite))
+    {
+        const uint32_t* pComposite = GetDefinition(module, module.workgroupSizeId);
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            sizeIds[i] = GetWord(pComposite, 3 + i);
+        }
+    }
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        uint64_t value = 0;
+        if ((sizeIds[i] != Unset) && GetConstantValue(module, sizeIds[i], &value))
+        {
+            pData->workgroupSize[i] = static_cast<uint32_t>(value);
+            pData->workgroupSizeSpecIds[i] = GetDecorations(module, sizeIds[i]).specId;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Find the descriptors, push constant blocks, stage inputs, specialization constants and workgroup size of a SPIR-V
+// module in one pass over its words, without building a SPIRV-Cross compiler. Returns false if the module is
+// malformed.
+//
+// NOTE: The pass stops at the first function, all global declarations precede it.
+bool ReflectSpirv(
+    const uint32_t*    pCode,
+    size_t             wordCount,
+    SpvReflectionData* pData)      // [out] Reflected resources
+{
+    if ((wordCount < HeaderWordCount) || (wordCount > UINT32_MAX) || (pCode[3] > MaxIdBound))
+    {
+        return false;
+    }
+
+    SpvReflectedModule module = {};
+    module.pCode = pCode;
+    module.idBound = pCode[3];
+    module.definitions.assign(module.idBound, 0);
+    module.decorationIndices.assign(module.idBound, Unset);
+    module.workgroupSizeId = Unset;
+    bool hasLocalSize = false;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        module.localSizeIds[i] = Unset;
+        pData->workgroupSize[i] = 0;
+        pData->workgroupSizeSpecIds[i] = SpvReflectNoSpecId;
+    }
+
+    size_t offset = HeaderWordCount;
+    while (offset < wordCount)
+    {
+        const uint32_t* pInst = pCode + offset;
+        const uint32_t instWordCount = pInst[0] >> 16;
+        const uint16_t opcode = static_cast<uint16_t>(pInst[0] & 0xFFFF);
+        if ((instWordCount == 0) || (instWordCount > wordCount - offset))
+        {
+            return false;
+        }
+        if (opcode == OpFunction)
+        {
+            break;
+        }
+
+        // Result ID of the types, constants and variables, which are looked up by ID
+        uint32_t resultId = Unset;
+        switch (opcode)
+        {
+        case OpExecutionMode:
+            if ((hasLocalSize == false) && (instWordCount >= 6) && (pInst[2] == ExecutionModeLocalSize))
+            {
+                pData->workgroupSize[0] = pInst[3];
+                pData->workgroupSize[1] = pInst[4];
+                pData->workgroupSize[2] = pInst[5];
+                hasLocalSize = true;
+            }
+            break;
+        case OpExecutionModeId:
+            if ((hasLocalSize == false) && (instWordCount >= 6) && (pInst[2] == ExecutionModeLocalSizeId))
+            {
+                // The constants are defined after the execution modes
+                module.localSizeIds[0] = pInst[3];
+                module.localSizeIds[1] = pInst[4];
+                module.localSizeIds[2] = pInst[5];
+                hasLocalSize = true;
+            }
+            break;
+        case OpDecorate:
+            if (instWordCount >= 3)
+            {
+                if (pInst[1] >= module.idBound)
+                {
+                    return false;
+                }
+                RecordDecoration(&module, pInst);
+            }
+            break;
+        case OpMemberDecorate:
+            if ((instWordCount >= 5) && ((pInst[3] == DecorationOffset) || (pInst[3] == DecorationMatrixStride)))
+            {
+                const MemberDecoration decoration = { pInst[1], pInst[2], pInst[3], pInst[4] };
+                module.memberDecorations.push_back(decoration);
+            }
+            else if ((instWordCount >= 4) && (pInst[3] == DecorationRowMajor))
+            {
+                // RowMajor has no operand, it is recorded with the value 1
+                const MemberDecoration decoration = { pInst[1], pInst[2], pInst[3], 1 };
+                module.memberDecorations.push_back(decoration);
+            }
+            break;
+        case OpTypeBool:
+        case OpTypeInt:
+        case OpTypeFloat:
+        case OpTypeVector:
+        case OpTypeMatrix:
+        case OpTypeImage:
+        case OpTypeSampler:
+        case OpTypeSampledImage:
+        case OpTypeArray:
+        case OpTypeRuntimeArray:
+        case OpTypeStruct:
+        case OpTypePointer:
+        case OpTypeAccelerationStructure:
+            resultId = GetWord(pInst, 1);
+            break;
+        case OpConstantTrue:
+        case OpConstantFalse:
+        case OpConstant:
+        case OpConstantComposite:
+        case OpSpecConstantTrue:
+        case OpSpecConstantFalse:
+        case OpSpecConstant:
+        case OpSpecConstantComposite:
+        case OpVariable:
+            resultId = GetWord(pInst, 2);
+            break;
+        default:
+            break;
+        }
+
+        if (resultId != Unset)
+        {
+            if ((instWordCount < 2) || (resultId >= module.idBound))
+            {
+                return false;
+            }
+            module.definitions[resultId] = static_cast<uint32_t>(offset);
+
+            if (opcode == OpVariable)
+            {
+                ReflectVariable(&module, pInst, pData);
+            }
+            else if ((opcode == OpSpecConstantTrue) || (opcode == OpSpecConstantFalse) || (opcode == OpSpecConstant))
+            {
+                ReflectSpecConstant(module, pInst, pData);
+            }
+        }
+
+        offset += instWordCount;
+    }
+
+    std::sort(module.memberDecorations.begin(), module.memberDecorations.end(), IsMemberBefore);
+    for (size_t i = 0; i < pData->pushConstants.size(); ++i)
+    {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        GetMemberRange(module, module.pushConstantTypes[i], 0, &begin, &end);
+        pData->pushConstants[i].offset = begin;
+        pData->pushConstants[i].size = end - begin;
+    }
+
+    ReflectWorkgroupSize(module, pData);
+    return true;
+}
@@ -0,0 +1,59 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  reflect.h
+* @brief SPVGEN header file: contains the declaration of the resource reflection of SPIR-V modules.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "spvgen.h"
+
+// Resources of a SPIR-V module found by ReflectSpirv
+struct SpvReflectionData
+{
+    uint32_t                            workgroupSize[3];
+    uint32_t                            workgroupSizeSpecIds[3];
+    std::vector<SpvReflectDescriptor>   descriptors;
+    std::vector<SpvReflectPushConstant> pushConstants;
+    std::vector<SpvReflectInput>        inputs;
+    std::vector<SpvReflectSpecConstant> specConstants;
+};
+
+// =====================================================================================================================
+// Find the descriptors, push constant blocks, stage inputs, specialization constants and workgroup size of a SPIR-V
+// module in one pass over its words, without building a SPIRV-Cross compiler. Returns false if the module is
+// malformed.
+//
+// NOTE: The pass stops at the first function, all global declarations precede it.
+bool ReflectSpirv(
+    const uint32_t*    pCode,
+    size_t             wordCount,
+    SpvReflectionData* pData);
@@ -67,11 +67,13 @@
 //
 
 // this only applies to the standalone wrapper, not the front end in general
+#include "glslang/Include/PoolAlloc.h"
 #include "glslang/Include/ShHandle.h"
 #include "glslang/Public/ShaderLang.h"
 #include "glslang/build_info.h"
 #include "StandAlone/DirStackFileIncluder.h"
 #include "SPIRV/GlslangToSpv.h"
+#include "SPIRV/SpvTools.h"
 
 #include "spirv-tools/libspirv.h"
 #include "spirv-tools/optimizer.hpp"
@@ -95,23 +97,64 @@ using namespace spv;
 #include "spirv_reflect.hpp"
 
 #include "disassemble.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <stdarg.h>
 
 #include "spvgen.h"
+#include "compileCache.h"
+#include "diagnostics.h"
+#include "disassemblyStream.h"
+#include "fingerprint.h"
+#include "diskCache.h"
+#include "includeCache.h"
+#include "mappedFile.h"
+#include "memoryTracker.h"
+#include "reflect.h"
+#include "threadPool.h"
 
 // Forward declarations
 EShLanguage SpvGenStageToEShLanguage(SpvGenStage stage);
+SpvGenStage EShLanguageToSpvGenStage(EShLanguage stage);
 bool ReadFileData(const char* pFileName, std::string& data);
 int Vsnprintf(char* pOutput, size_t bufSize, const char* pFormat, va_list argList);
 int Snprintf(char* pOutput, size_t bufSize, const char* pFormat, ...);
 spv_result_t spvDiagnosticPrint(const spv_diagnostic diagnostic, char* pBuffer, size_t bufferSize);
 
-TBuiltInResource Resources;
+// Represents a compiler context: the resource limits, the default options and the compile caches used by a compile.
+//
+// NOTE: The resource limits and the default options never change after the context is created, so a context may be
+// used by many threads concurrently. The caches of the default context can be replaced at any time, they are accessed
+// with atomic loads and stores.
+struct SpvContext
+{
+    TBuiltInResource                 resources;
+    int                              defaultOptions;
+    std::shared_ptr<SpvCompileCache> pCompileCache;       // Null if the compile cache is disabled
+    std::shared_ptr<SpvDiskCache>    pCompileDiskCache;   // Null if the persistent compile cache is disabled
+};
+
 std::string* pConfigFile;
-int DefaultOptions = SpvGenOptionDefaultDesktop | SpvGenOptionVulkanRules;
+SpvContext DefaultContext = { {}, SpvGenOptionDefaultDesktop | SpvGenOptionVulkanRules };   // Process-wide context
+std::mutex                       AllocatorLock;
+SpvAllocationCallbacks           GlobalAllocator = {}; // Output buffer allocator, null callbacks mean malloc/free
+thread_local uint64_t            ThreadMemoryBudget = 0; // Memory budget of the calls of this thread, 0 means none
+thread_local SpvMemoryStats      LastMemoryStats = {};   // Memory statistics of the last tracked call of this thread
+
+// SPIRV-Tools contexts of the assembler, disassembler and validator, one per target environment, built on first use
+std::atomic<spv_context>         SpirvToolsContexts[SPV_ENV_MAX] = {};
+std::atomic<uint64_t>            SpirvToolsContextCreateCount(0);
 
 //
 // These are the default resources for TBuiltInResources, used for both
@@ -225,255 +268,265 @@ const char* DefaultConfig =
     ;
 
 // =====================================================================================================================
-// Parse either a .conf file provided by the user or the default string above.
-void ProcessConfigFile()
+// Parse resource limits in the format of a .conf file, returns false if the configuration is malformed
+bool ParseResourceConfig(
+    const char*       pConfig,      // [in] Configuration text
+    TBuiltInResource* pResources)   // [out] Resource limits
 {
-    const char* config = 0;
-    std::string configData;
-
-    if (pConfigFile == nullptr)
-    {
-        pConfigFile = new(std::string);
-    }
-
-    if (pConfigFile->size() > 0)
-    {
-        if (ReadFileData(pConfigFile->c_str(), configData))
-        {
-            config = configData.c_str();
-        }
-        else
-        {
-            printf("Error opening configuration file; will instead use the default configuration\n");
-        }
-    }
-
-    if (config == 0)
-    {
-        configData = DefaultConfig;
-        config = configData.c_str();
-    }
-
-    const char* delims = " \t\n\r";
-    const char* token = strtok(const_cast<char*>(config), delims);
-    while (token) {
-        const char* valueStr = strtok(0, delims);
-        if (valueStr == 0 || ! (valueStr[0] == '-' || (valueStr[0] >= '0' && valueStr[0] <= '9'))) {
-            printf("Error: '%s' bad .conf file.  Each name must be followed by one number.\n", valueStr ? valueStr : "");
-            return;
+    // NOTE: strtok() isn't used, as contexts may be created concurrently.
+    std::istringstream configStream(pConfig);
+    std::string tokenStr;
+    while (configStream >> tokenStr) {
+        std::string valueStr;
+        if (!(configStream >> valueStr) || ! (valueStr[0] == '-' || (valueStr[0] >= '0' && valueStr[0] <= '9'))) {
+            printf("Error: '%s' bad .conf file.  Each name must be followed by one number.\n", valueStr.c_str());
+            return false;
         }
-        int value = atoi(valueStr);
+        const char* token = tokenStr.c_str();
+        int value = atoi(valueStr.c_str());
 
         if (strcmp(token, "MaxLights") == 0)
-            Resources.maxLights = value;
+            pResources->maxLights = value;
         else if (strcmp(token, "MaxClipPlanes") == 0)
-            Resources.maxClipPlanes = value;
+            pResources->maxClipPlanes = value;
         else if (strcmp(token, "MaxTextureUnits") == 0)
-            Resources.maxTextureUnits = value;
+            pResources->maxTextureUnits = value;
         else if (strcmp(token, "MaxTextureCoords") == 0)
-            Resources.maxTextureCoords = value;
+            pResources->maxTextureCoords = value;
         else if (strcmp(token, "MaxVertexAttribs") == 0)
-            Resources.maxVertexAttribs = value;
+            pResources->maxVertexAttribs = value;
         else if (strcmp(token, "MaxVertexUniformComponents") == 0)
-            Resources.maxVertexUniformComponents = value;
+            pResources->maxVertexUniformComponents = value;
         else if (strcmp(token, "MaxVaryingFloats") == 0)
-            Resources.maxVaryingFloats = value;
+            pResources->maxVaryingFloats = value;
         else if (strcmp(token, "MaxVertexTextureImageUnits") == 0)
-            Resources.maxVertexTextureImageUnits = value;
+            pResources->maxVertexTextureImageUnits = value;
         else if (strcmp(token, "MaxCombinedTextureImageUnits") == 0)
-            Resources.maxCombinedTextureImageUnits = value;
+            pResources->maxCombinedTextureImageUnits = value;
         else if (strcmp(token, "MaxTextureImageUnits") == 0)
-            Resources.maxTextureImageUnits = value;
+            pResources->maxTextureImageUnits = value;
         else if (strcmp(token, "MaxFragmentUniformComponents") == 0)
-            Resources.maxFragmentUniformComponents = value;
+            pResources->maxFragmentUniformComponents = value;
         else if (strcmp(token, "MaxDrawBuffers") == 0)
-            Resources.maxDrawBuffers = value;
+            pResources->maxDrawBuffers = value;
         else if (strcmp(token, "MaxVertexUniformVectors") == 0)
-            Resources.maxVertexUniformVectors = value;
+            pResources->maxVertexUniformVectors = value;
         else if (strcmp(token, "MaxVaryingVectors") == 0)
-            Resources.maxVaryingVectors = value;
+            pResources->maxVaryingVectors = value;
         else if (strcmp(token, "MaxFragmentUniformVectors") == 0)
-            Resources.maxFragmentUniformVectors = value;
+            pResources->maxFragmentUniformVectors = value;
         else if (strcmp(token, "MaxVertexOutputVectors") == 0)
-            Resources.maxVertexOutputVectors = value;
+            pResources->maxVertexOutputVectors = value;
         else if (strcmp(token, "MaxFragmentInputVectors") == 0)
-            Resources.maxFragmentInputVectors = value;
+            pResources->maxFragmentInputVectors = value;
         else if (strcmp(token, "MinProgramTexelOffset") == 0)
-            Resources.minProgramTexelOffset = value;
+            pResources->minProgramTexelOffset = value;
         else if (strcmp(token, "MaxProgramTexelOffset") == 0)
-            Resources.maxProgramTexelOffset = value;
+            pResources->maxProgramTexelOffset = value;
         else if (strcmp(token, "MaxClipDistances") == 0)
-            Resources.maxClipDistances = value;
+            pResources->maxClipDistances = value;
         else if (strcmp(token, "MaxComputeWorkGroupCountX") == 0)
-            Resources.maxComputeWorkGroupCountX = value;
+            pResources->maxComputeWorkGroupCountX = value;
         else if (strcmp(token, "MaxComputeWorkGroupCountY") == 0)
-            Resources.maxComputeWorkGroupCountY = value;
+            pResources->maxComputeWorkGroupCountY = value;
         else if (strcmp(token, "MaxComputeWorkGroupCountZ") == 0)
-            Resources.maxComputeWorkGroupCountZ = value;
+            pResources->maxComputeWorkGroupCountZ = value;
         else if (strcmp(token, "MaxComputeWorkGroupSizeX") == 0)
-            Resources.maxComputeWorkGroupSizeX = value;
+            pResources->maxComputeWorkGroupSizeX = value;
         else if (strcmp(token, "MaxComputeWorkGroupSizeY") == 0)
-            Resources.maxComputeWorkGroupSizeY = value;
+            pResources->maxComputeWorkGroupSizeY = value;
         else if (strcmp(token, "MaxComputeWorkGroupSizeZ") == 0)
-            Resources.maxComputeWorkGroupSizeZ = value;
+            pResources->maxComputeWorkGroupSizeZ = value;
         else if (strcmp(token, "MaxComputeUniformComponents") == 0)
-            Resources.maxComputeUniformComponents = value;
+            pResources->maxComputeUniformComponents = value;
         else if (strcmp(token, "MaxComputeTextureImageUnits") == 0)
-            Resources.maxComputeTextureImageUnits = value;
+            pResources->maxComputeTextureImageUnits = value;
         else if (strcmp(token, "MaxComputeImageUniforms") == 0)
-            Resources.maxComputeImageUniforms = value;
+            pResources->maxComputeImageUniforms = value;
         else if (strcmp(token, "MaxComputeAtomicCounters") == 0)
-            Resources.maxComputeAtomicCounters = value;
+            pResources->maxComputeAtomicCounters = value;
         else if (strcmp(token, "MaxComputeAtomicCounterBuffers") == 0)
-            Resources.maxComputeAtomicCounterBuffers = value;
+            pResources->maxComputeAtomicCounterBuffers = value;
         else if (strcmp(token, "MaxVaryingComponents") == 0)
-            Resources.maxVaryingComponents = value;
+            pResources->maxVaryingComponents = value;
         else if (strcmp(token, "MaxVertexOutputComponents") == 0)
-            Resources.maxVertexOutputComponents = value;
+            pResources->maxVertexOutputComponents = value;
         else if (strcmp(token, "MaxGeometryInputComponents") == 0)
-            Resources.maxGeometryInputComponents = value;
+            pResources->maxGeometryInputComponents = value;
         else if (strcmp(token, "MaxGeometryOutputComponents") == 0)
-            Resources.maxGeometryOutputComponents = value;
+            pResources->maxGeometryOutputComponents = value;
         else if (strcmp(token, "MaxFragmentInputComponents") == 0)
-            Resources.maxFragmentInputComponents = value;
+            pResources->maxFragmentInputComponents = value;
         else if (strcmp(token, "MaxImageUnits") == 0)
-            Resources.maxImageUnits = value;
+            pResources->maxImageUnits = value;
         else if (strcmp(token, "MaxCombinedImageUnitsAndFragmentOutputs") == 0)
-            Resources.maxCombinedImageUnitsAndFragmentOutputs = value;
+            pResources->maxCombinedImageUnitsAndFragmentOutputs = value;
         else if (strcmp(token, "MaxCombinedShaderOutputResources") == 0)
-            Resources.maxCombinedShaderOutputResources = value;
+            pResources->maxCombinedShaderOutputResources = value;
         else if (strcmp(token, "MaxImageSamples") == 0)
-            Resources.maxImageSamples = value;
+            pResources->maxImageSamples = value;
         else if (strcmp(token, "MaxVertexImageUniforms") == 0)
-            Resources.maxVertexImageUniforms = value;
+            pResources->maxVertexImageUniforms = value;
         else if (strcmp(token, "MaxTessControlImageUniforms") == 0)
-            Resources.maxTessControlImageUniforms = value;
+            pResources->maxTessControlImageUniforms = value;
         else if (strcmp(token, "MaxTessEvaluationImageUniforms") == 0)
-            Resources.maxTessEvaluationImageUniforms = value;
+            pResources->maxTessEvaluationImageUniforms = value;
         else if (strcmp(token, "MaxGeometryImageUniforms") == 0)
-            Resources.maxGeometryImageUniforms = value;
+            pResources->maxGeometryImageUniforms = value;
         else if (strcmp(token, "MaxFragmentImageUniforms") == 0)
-            Resources.maxFragmentImageUniforms = value;
+            pResources->maxFragmentImageUniforms = value;
         else if (strcmp(token, "MaxCombinedImageUniforms") == 0)
-            Resources.maxCombinedImageUniforms = value;
+            pResources->maxCombinedImageUniforms = value;
         else if (strcmp(token, "MaxGeometryTextureImageUnits") == 0)
-            Resources.maxGeometryTextureImageUnits = value;
+            pResources->maxGeometryTextureImageUnits = value;
         else if (strcmp(token, "MaxGeometryOutputVertices") == 0)
-            Resources.maxGeometryOutputVertices = value;
+            pResources->maxGeometryOutputVertices = value;
         else if (strcmp(token, "MaxGeometryTotalOutputComponents") == 0)
-            Resources.maxGeometryTotalOutputComponents = value;
+            pResources->maxGeometryTotalOutputComponents = value;
         else if (strcmp(token, "MaxGeometryUniformComponents") == 0)
-            Resources.maxGeometryUniformComponents = value;
+            pResources->maxGeometryUniformComponents = value;
         else if (strcmp(token, "MaxGeometryVaryingComponents") == 0)
-            Resources.maxGeometryVaryingComponents = value;
+            pResources->maxGeometryVaryingComponents = value;
         else if (strcmp(token, "MaxTessControlInputComponents") == 0)
-            Resources.maxTessControlInputComponents = value;
+            pResources->maxTessControlInputComponents = value;
         else if (strcmp(token, "MaxTessControlOutputComponents") == 0)
-            Resources.maxTessControlOutputComponents = value;
+            pResources->maxTessControlOutputComponents = value;
         else if (strcmp(token, "MaxTessControlTextureImageUnits") == 0)
-            Resources.maxTessControlTextureImageUnits = value;
+            pResources->maxTessControlTextureImageUnits = value;
         else if (strcmp(token, "MaxTessControlUniformComponents") == 0)
-            Resources.maxTessControlUniformComponents = value;
+            pResources->maxTessControlUniformComponents = value;
         else if (strcmp(token, "MaxTessControlTotalOutputComponents") == 0)
-            Resources.maxTessControlTotalOutputComponents = value;
+            pResources->maxTessControlTotalOutputComponents = value;
         else if (strcmp(token, "MaxTessEvaluationInputComponents") == 0)
-            Resources.maxTessEvaluationInputComponents = value;
+            pResources->maxTessEvaluationInputComponents = value;
         else if (strcmp(token, "MaxTessEvaluationOutputComponents") == 0)
-            Resources.maxTessEvaluationOutputComponents = value;
+            pResources->maxTessEvaluationOutputComponents = value;
         else if (strcmp(token, "MaxTessEvaluationTextureImageUnits") == 0)
-            Resources.maxTessEvaluationTextureImageUnits = value;
+            pResources->maxTessEvaluationTextureImageUnits = value;
         else if (strcmp(token, "MaxTessEvaluationUniformComponents") == 0)
-            Resources.maxTessEvaluationUniformComponents = value;
+            pResources->maxTessEvaluationUniformComponents = value;
         else if (strcmp(token, "MaxTessPatchComponents") == 0)
-            Resources.maxTessPatchComponents = value;
+            pResources->maxTessPatchComponents = value;
         else if (strcmp(token, "MaxPatchVertices") == 0)
-            Resources.maxPatchVertices = value;
+            pResources->maxPatchVertices = value;
         else if (strcmp(token, "MaxTessGenLevel") == 0)
-            Resources.maxTessGenLevel = value;
+            pResources->maxTessGenLevel = value;
         else if (strcmp(token, "MaxViewports") == 0)
-            Resources.maxViewports = value;
+            pResources->maxViewports = value;
         else if (strcmp(token, "MaxVertexAtomicCounters") == 0)
-            Resources.maxVertexAtomicCounters = value;
+            pResources->maxVertexAtomicCounters = value;
         else if (strcmp(token, "MaxTessControlAtomicCounters") == 0)
-            Resources.maxTessControlAtomicCounters = value;
+            pResources->maxTessControlAtomicCounters = value;
         else if (strcmp(token, "MaxTessEvaluationAtomicCounters") == 0)
-            Resources.maxTessEvaluationAtomicCounters = value;
+            pResources->maxTessEvaluationAtomicCounters = value;
         else if (strcmp(token, "MaxGeometryAtomicCounters") == 0)
-            Resources.maxGeometryAtomicCounters = value;
+            pResources->maxGeometryAtomicCounters = value;
         else if (strcmp(token, "MaxFragmentAtomicCounters") == 0)
-            Resources.maxFragmentAtomicCounters = value;
+            pResources->maxFragmentAtomicCounters = value;
         else if (strcmp(token, "MaxCombinedAtomicCounters") == 0)
-            Resources.maxCombinedAtomicCounters = value;
+            pResources->maxCombinedAtomicCounters = value;
         else if (strcmp(token, "MaxAtomicCounterBindings") == 0)
-            Resources.maxAtomicCounterBindings = value;
+            pResources->maxAtomicCounterBindings = value;
         else if (strcmp(token, "MaxVertexAtomicCounterBuffers") == 0)
-            Resources.maxVertexAtomicCounterBuffers = value;
+            pResources->maxVertexAtomicCounterBuffers = value;
         else if (strcmp(token, "MaxTessControlAtomicCounterBuffers") == 0)
-            Resources.maxTessControlAtomicCounterBuffers = value;
+            pResources->maxTessControlAtomicCounterBuffers = value;
         else if (strcmp(token, "MaxTessEvaluationAtomicCounterBuffers") == 0)
-            Resources.maxTessEvaluationAtomicCounterBuffers = value;
+            pResources->maxTessEvaluationAtomicCounterBuffers = value;
         else if (strcmp(token, "MaxGeometryAtomicCounterBuffers") == 0)
-            Resources.maxGeometryAtomicCounterBuffers = value;
+            pResources->maxGeometryAtomicCounterBuffers = value;
         else if (strcmp(token, "MaxFragmentAtomicCounterBuffers") == 0)
-            Resources.maxFragmentAtomicCounterBuffers = value;
+            pResources->maxFragmentAtomicCounterBuffers = value;
         else if (strcmp(token, "MaxCombinedAtomicCounterBuffers") == 0)
-            Resources.maxCombinedAtomicCounterBuffers = value;
+            pResources->maxCombinedAtomicCounterBuffers = value;
         else if (strcmp(token, "MaxAtomicCounterBufferSize") == 0)
-            Resources.maxAtomicCounterBufferSize = value;
+            pResources->maxAtomicCounterBufferSize = value;
         else if (strcmp(token, "MaxTransformFeedbackBuffers") == 0)
-            Resources.maxTransformFeedbackBuffers = value;
+            pResources->maxTransformFeedbackBuffers = value;
         else if (strcmp(token, "MaxTransformFeedbackInterleavedComponents") == 0)
-            Resources.maxTransformFeedbackInterleavedComponents = value;
+            pResources->maxTransformFeedbackInterleavedComponents = value;
         else if (strcmp(token, "MaxCullDistances") == 0)
-            Resources.maxCullDistances = value;
+            pResources->maxCullDistances = value;
         else if (strcmp(token, "MaxCombinedClipAndCullDistances") == 0)
-            Resources.maxCombinedClipAndCullDistances = value;
+            pResources->maxCombinedClipAndCullDistances = value;
         else if (strcmp(token, "MaxSamples") == 0)
-            Resources.maxSamples = value;
+            pResources->maxSamples = value;
         else if (strcmp(token, "MaxMeshOutputVerticesEXT") == 0)
-            Resources.maxMeshOutputVerticesEXT = value;
+            pResources->maxMeshOutputVerticesEXT = value;
         else if (strcmp(token, "MaxMeshOutputPrimitivesEXT") == 0)
-            Resources.maxMeshOutputPrimitivesEXT = value;
+            pResources->maxMeshOutputPrimitivesEXT = value;
         else if (strcmp(token, "MaxMeshWorkGroupSizeX_EXT") == 0)
-            Resources.maxMeshWorkGroupSizeX_EXT = value;
+            pResources->maxMeshWorkGroupSizeX_EXT = value;
         else if (strcmp(token, "MaxMeshWorkGroupSizeY_EXT") == 0)
-            Resources.maxMeshWorkGroupSizeY_EXT = value;
+            pResources->maxMeshWorkGroupSizeY_EXT = value;
         else if (strcmp(token, "MaxMeshWorkGroupSizeZ_EXT") == 0)
-            Resources.maxMeshWorkGroupSizeZ_EXT = value;
+            pResources->maxMeshWorkGroupSizeZ_EXT = value;
         else if (strcmp(token, "MaxTaskWorkGroupSizeX_EXT") == 0)
-            Resources.maxTaskWorkGroupSizeX_EXT = value;
+            pResources->maxTaskWorkGroupSizeX_EXT = value;
         else if (strcmp(token, "MaxTaskWorkGroupSizeY_EXT") == 0)
-            Resources.maxTaskWorkGroupSizeY_EXT = value;
+            pResources->maxTaskWorkGroupSizeY_EXT = value;
         else if (strcmp(token, "MaxTaskWorkGroupSizeZ_EXT") == 0)
-            Resources.maxTaskWorkGroupSizeZ_EXT = value;
+            pResources->maxTaskWorkGroupSizeZ_EXT = value;
         else if (strcmp(token, "MaxMeshViewCountEXT") == 0)
-            Resources.maxMeshViewCountEXT = value;
+            pResources->maxMeshViewCountEXT = value;
         else if (strcmp(token, "MaxDualSourceDrawBuffersEXT") == 0)
-            Resources.maxDualSourceDrawBuffersEXT = value;
+            pResources->maxDualSourceDrawBuffersEXT = value;
 
         else if (strcmp(token, "nonInductiveForLoops") == 0)
-            Resources.limits.nonInductiveForLoops = (value != 0);
+            pResources->limits.nonInductiveForLoops = (value != 0);
         else if (strcmp(token, "whileLoops") == 0)
-            Resources.limits.whileLoops = (value != 0);
+            pResources->limits.whileLoops = (value != 0);
         else if (strcmp(token, "doWhileLoops") == 0)
-            Resources.limits.doWhileLoops = (value != 0);
+            pResources->limits.doWhileLoops = (value != 0);
         else if (strcmp(token, "generalUniformIndexing") == 0)
-            Resources.limits.generalUniformIndexing = (value != 0);
+            pResources->limits.generalUniformIndexing = (value != 0);
         else if (strcmp(token, "generalAttributeMatrixVectorIndexing") == 0)
-            Resources.limits.generalAttributeMatrixVectorIndexing = (value != 0);
+            pResources->limits.generalAttributeMatrixVectorIndexing = (value != 0);
         else if (strcmp(token, "generalVaryingIndexing") == 0)
-            Resources.limits.generalVaryingIndexing = (value != 0);
+            pResources->limits.generalVaryingIndexing = (value != 0);
         else if (strcmp(token, "generalSamplerIndexing") == 0)
-            Resources.limits.generalSamplerIndexing = (value != 0);
+            pResources->limits.generalSamplerIndexing = (value != 0);
         else if (strcmp(token, "generalVariableIndexing") == 0)
-            Resources.limits.generalVariableIndexing = (value != 0);
+            pResources->limits.generalVariableIndexing = (value != 0);
         else if (strcmp(token, "generalConstantMatrixVectorIndexing") == 0)
-            Resources.limits.generalConstantMatrixVectorIndexing = (value != 0);
+            pResources->limits.generalConstantMatrixVectorIndexing = (value != 0);
         else
             printf("Warning: unrecognized limit (%s) in configuration file.\n", token);
+    }
+
+    return true;
+}
+
+// =====================================================================================================================
+// Parse either a .conf file provided by the user or the default string above.
+void ProcessConfigFile()
+{
+    const char* config = nullptr;
+    std::string configData;
+
+    if (pConfigFile == nullptr)
+    {
+        pConfigFile = new(std::string);
+    }
+
+    if (pConfigFile->size() > 0)
+    {
+        if (ReadFileData(pConfigFile->c_str(), configData))
+        {
+            config = configData.c_str();
+        }
+        else
+        {
+            printf("Error opening configuration file; will instead use the default configuration\n");
+        }
+    }
 
-        token = strtok(0, delims);
+    if (config == nullptr)
+    {
+        config = DefaultConfig;
     }
+
+    ParseResourceConfig(config, &DefaultContext.resources);
 }
 
 // =====================================================================================================================
@@ -525,20 +578,48 @@ spv_target_env GetSpirvTargetEnv(
 }
 
 // =====================================================================================================================
-// Get SPIR-V target environment from the input SPIR-V text
+// Get SPIR-V target environment from the input SPIR-V text. Only the comment lines at the start of the text are
+// scanned, they hold the header written by the disassembler, e.g. "; Version: 1.5".
 spv_target_env GetSpirvTargetEnv(
-    const char* pSpvText)
+    const char* pSpvText,
+    size_t      textLength)   // Length of the text, it doesn't have to be null terminated
 {
     spv_target_env targetEnv = SPV_ENV_UNIVERSAL_1_3; // Set the default to SPIR-V 1.3
 
-    std::string spvText(pSpvText);
+    static const char VersionPrefix[] = "; Version: ";
+    const size_t versionPrefixLength = sizeof(VersionPrefix) - 1;
+
+    const char* pVersion = nullptr;
+    const char* pLine = pSpvText;
+    const char* pEnd = pSpvText + textLength;
+    while (pLine < pEnd)
+    {
+        if ((*pLine == ' ') || (*pLine == '\t') || (*pLine == '\r') || (*pLine == '\n'))
+        {
+            ++pLine;
+            continue;
+        }
+        if (*pLine != ';')
+        {
+            // End of the header comments
+            break;
+        }
+
+        const char* pLineEnd = static_cast<const char*>(memchr(pLine, '\n', pEnd - pLine));
+        pLineEnd = (pLineEnd != nullptr) ? pLineEnd : pEnd;
+        if ((static_cast<size_t>(pLineEnd - pLine) >= versionPrefixLength + 3) &&
+            (memcmp(pLine, VersionPrefix, versionPrefixLength) == 0))
+        {
+            pVersion = pLine + versionPrefixLength;
+            break;
+        }
+        pLine = pLineEnd;
+    }
 
-    auto pos = spvText.find("; Version: ");
-    if (pos != std::string::npos)
+    if (pVersion != nullptr)
     {
-        pos += strlen("; Version: ");
-        unsigned int versionMajor = spvText[pos] - '0';
-        unsigned int versionMinor = spvText[pos + 2] - '0';
+        unsigned int versionMajor = pVersion[0] - '0';
+        unsigned int versionMinor = pVersion[2] - '0';
         if ((versionMajor == 1) && (versionMinor == 0))
         {
             targetEnv = SPV_ENV_UNIVERSAL_1_0;
@@ -572,6 +653,48 @@ spv_target_env GetSpirvTargetEnv(
     return targetEnv;
 }
 
+// =====================================================================================================================
+// Get the SPIRV-Tools context of a target environment, it is created on first use and shared by all threads. Building
+// the grammar tables of a context is far more expensive than assembling, disassembling or validating a small module.
+//
+// NOTE: A context is only read by the assembler, disassembler and validator, so it may be used by several threads at
+// the same time. Its message consumer must never be set.
+static spv_context GetSpirvToolsContext(
+    spv_target_env targetEnv)
+{
+    std::atomic<spv_context>& slot = SpirvToolsContexts[targetEnv];
+    spv_context context = slot.load(std::memory_order_acquire);
+    if (context == nullptr)
+    {
+        spv_context newContext = spvContextCreate(targetEnv);
+        ++SpirvToolsContextCreateCount;
+        if (slot.compare_exchange_strong(context, newContext, std::memory_order_acq_rel))
+        {
+            context = newContext;
+        }
+        else
+        {
+            // Another thread created the context first, context holds its one now
+            spvContextDestroy(newContext);
+        }
+    }
+    return context;
+}
+
+// =====================================================================================================================
+// Destroy the shared SPIRV-Tools contexts, they are re-created on next use
+static void DestroySpirvToolsContexts()
+{
+    for (auto& slot : SpirvToolsContexts)
+    {
+        spv_context context = slot.exchange(nullptr);
+        if (context != nullptr)
+        {
+            spvContextDestroy(context);
+        }
+    }
+}
+
 // =====================================================================================================================
 // *.conf => this is a config file that can set limits/resources
 bool SetConfigFile(
@@ -609,6 +732,194 @@ void SetMessageOptions(EShMessages& messages, int options)
         messages = (EShMessages)(messages | EShMsgHlslEnable16BitTypes);
 }
 
+// =====================================================================================================================
+// Get the time elapsed since the specified time point in nanoseconds
+static uint64_t GetElapsedTime(
+    std::chrono::steady_clock::time_point startTime)
+{
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+// =====================================================================================================================
+// Create a glslang shader object for the specified stage, and apply the compile options to it
+glslang::TShader* CreateShader(
+    SpvGenStage        stageType,       // Shader stage
+    int                sourceCount,     // Number of source strings
+    const char* const* pSources,        // [in] Source strings
+    const char* const* pFileNames,      // [in] File names of the source strings, may be null
+    const char*        pEntryPoint,     // [in] Entry point name, may be null
+    const char*        pPreamble,       // [in] Text parsed ahead of the source strings, e.g. macro definitions, may be
+                                        // null
+    int                options)         // Compile options
+{
+    // Set the version of the input semantics.
+    const int ClientInputSemanticsVersion = 100;
+
+    EShLanguage stage = SpvGenStageToEShLanguage(stageType);
+    glslang::TShader* pShader = new glslang::TShader(stage);
+
+    if (pFileNames == nullptr)
+    {
+        pShader->setStrings(pSources, sourceCount);
+    }
+    else
+    {
+        pShader->setStringsWithLengthsAndNames(pSources, nullptr, pFileNames, sourceCount);
+    }
+
+    if (options & SpvGenOptionVulkanRules)
+    {
+        pShader->setEnvInput((options & SpvGenOptionReadHlsl) ? glslang::EShSourceHlsl : glslang::EShSourceGlsl,
+                            stage,
+                            glslang::EShClientVulkan,
+                            ClientInputSemanticsVersion);
+        pShader->setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
+    }
+    else
+    {
+        assert((options & SpvGenOptionReadHlsl) == 0); // Assume OGL don't use HLSL
+        pShader->setEnvInput((options & SpvGenOptionReadHlsl) ? glslang::EShSourceHlsl : glslang::EShSourceGlsl,
+                            stage,
+                            glslang::EShClientOpenGL,
+                            ClientInputSemanticsVersion);
+        pShader->setEnvClient(glslang::EShClientOpenGL, glslang::EShTargetOpenGL_450);
+    }
+
+    pShader->setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_6);
+
+    if (pEntryPoint != nullptr)
+    {
+        pShader->setEntryPoint(pEntryPoint);
+    }
+
+    if (pPreamble != nullptr)
+    {
+        pShader->setPreamble(pPreamble);
+    }
+
+    pShader->setFlattenUniformArrays((options & SpvGenOptionFlattenUniformArrays) != 0);
+
+    if (options & SpvGenOptionHlslIoMapping)
+    {
+        pShader->setHlslIoMapping(true);
+    }
+
+    if (options & SpvGenOptionAutoMapBindings)
+    {
+        pShader->setAutoMapBindings(true);
+    }
+
+    if (options & SpvGenOptionAutoMapLocations)
+    {
+        pShader->setAutoMapLocations(true);
+    }
+
+    if (options & SpvGenOptionInvertY)
+    {
+        pShader->setInvertY(true);
+    }
+
+    return pShader;
+}
+
+// =====================================================================================================================
+// Parse a shader created by CreateShader(), returns true on success
+//
+// NOTE: This is thread safe, shaders of the same program may be parsed concurrently. Include files are read through the
+// process-wide include cache. If the memory budget of the call is already exceeded the parse is skipped, and a parse
+// which exceeds it returns false once it is finished.
+bool ParseShader(
+    glslang::TShader*       pShader,      // [in] Shader to parse
+    EShMessages             messages,     // Parser messages
+    int                     options,      // Compile options
+    const TBuiltInResource* pResources,   // [in] Resource limits
+    SpvCompileStageStats*   pStats)       // [out] Parse time and include count, may be null
+{
+    auto startTime = std::chrono::steady_clock::now();
+    SpvCachedFileIncluder includer;
+    bool success = false;
+    if (SpvMemoryTracker::IsCurrentBudgetExceeded() == false)
+    {
+        success = pShader->parse(pResources,
+                                 (options & SpvGenOptionDefaultDesktop) ? 110 : 100,
+                                 false,
+                                 messages,
+                                 includer);
+        success = success && (SpvMemoryTracker::IsCurrentBudgetExceeded() == false);
+    }
+    if (pStats != nullptr)
+    {
+        pStats->parseTime = GetElapsedTime(startTime);
+        pStats->includeCount = includer.GetIncludeCount();
+    }
+    return success;
+}
+
+// =====================================================================================================================
+// Generate the SPIR-V binary of a linked stage with GlslangToSpv(). If glslang exposes its optimizer entry-points
+// (ENABLE_OPT), the built-in optimizer runs as a separate step under the same condition as in GlslangToSpv(), so that
+// code generation and optimization are timed separately. Otherwise the optimization is part of the generation time.
+void GenerateSpirv(
+    const glslang::TIntermediate& intermediate,   // [in] Linked intermediate tree of the stage
+    int                           options,        // Compile options
+    std::vector<unsigned int>*    pSpirv,         // [out] SPIR-V binary
+    SpvCompileStageStats*         pStats)         // [out] SPIR-V generation statistics
+{
+    glslang::SpvOptions spvOptions = {};
+    spvOptions.generateDebugInfo = (options & SpvGenOptionDebug) != 0;
+    spvOptions.disableOptimizer = (options & SpvGenOptionOptimizeDisable) != 0;
+    spvOptions.optimizeSize = (options & SpvGenOptionOptimizeSize) != 0;
+
+#if ENABLE_OPT
+    // HLSL is always legalized, GLSL is only optimized for size
+    const bool optimize = (spvOptions.disableOptimizer == false) &&
+                          (((options & SpvGenOptionReadHlsl) != 0) || spvOptions.optimizeSize);
+    spvOptions.disableOptimizer = true;
+#endif
+
+    auto startTime = std::chrono::steady_clock::now();
+    glslang::GlslangToSpv(intermediate, *pSpirv, &spvOptions);
+    pStats->spirvGenTime = GetElapsedTime(startTime);
+    pStats->spirvWordCount = static_cast<uint32_t>(pSpirv->size());
+    pStats->optimizeTime = 0;
+
+#if ENABLE_OPT
+    if (optimize)
+    {
+        spvOptions.disableOptimizer = false;
+        spv::SpvBuildLogger logger;
+        startTime = std::chrono::steady_clock::now();
+        glslang::SpirvToolsTransform(intermediate, *pSpirv, &logger, &spvOptions);
+        pStats->optimizeTime = GetElapsedTime(startTime);
+    }
+#endif
+    pStats->optimizedWordCount = static_cast<uint32_t>(pSpirv->size());
+}
+
+// =====================================================================================================================
+// Gives the calling thread a glslang pool allocator of its own while it is alive. GlslangToSpv() allocates temporary
+// types from the pool of the current thread, which on a worker thread may belong to a shader that is already released.
+class SpvPoolAllocatorScope
+{
+public:
+    SpvPoolAllocatorScope()
+        :
+        previousPool(glslang::GetThreadPoolAllocator())
+    {
+        glslang::SetThreadPoolAllocator(&pool);
+    }
+
+    ~SpvPoolAllocatorScope()
+    {
+        glslang::SetThreadPoolAllocator(&previousPool);
+    }
+
+private:
+    glslang::TPoolAllocator& previousPool;
+    glslang::TPoolAllocator  pool;
+};
+
 // =====================================================================================================================
 // Represents the result of spvCompileAndLinkProgram*
 class SpvProgram
@@ -617,7 +928,8 @@ public:
     // Constructor
     SpvProgram(uint32_t stageCount)
         :
-        spirvs(stageCount)
+        spirvs(stageCount),
+        stageStats(stageCount)
     {
         programs.push_back(new glslang::TProgram);
     }
@@ -650,18 +962,6 @@ public:
         return GetCurrentProgram()->mapIO();
     }
 
-    // Get link log from current program
-    const char* getInfoLog()
-    {
-        return GetCurrentProgram()->getInfoLog();
-    }
-
-    // Get link debug log from current program
-    const char* getInfoDebugLog()
-    {
-        return GetCurrentProgram()->getInfoLog();
-    }
-
     // Get intermediate tree from current program with specified shader stage
     glslang::TIntermediate* getIntermediate(
         EShLanguage stage
@@ -674,42 +974,89 @@ public:
     void AddLog(
         const char* log)
     {
-        programLog += log;
+        if (log[0] != '\0')
+        {
+            diagnostics.AddLog(log, SpvDiagnosticList::PhaseText, SpvGenStageInvalid);
+            logFormatted = false;
+        }
     };
 
-    // Format link info
-    void FormatLinkInfo(
-        const char*  linkInfo,
-        std::string& formatedString)
-    {
-        char buffer[256];
-        char* infoEntry[EShLangCount] = {};
-        int length = (int)strlen(linkInfo);
-        char* pInfoCopy = new char [length + 1];
-        char* pLog = pInfoCopy;
-        strcpy(pLog, linkInfo);
-        for (int i = 0; i < EShLangCount; ++i)
-        {
-            sprintf(buffer, "\nLinked %s stage:\n\n", glslang::StageName((EShLanguage)i));
-            infoEntry[i] = strstr(pLog, buffer);
-            if (infoEntry[i] != NULL)
-            {
-                infoEntry[i][0] = '\0';
-                infoEntry[i] += strlen(buffer);
-                pLog = infoEntry[i];
-            }
+    // Add the diagnostics of another log to SPV program log
+    void AddLog(
+        const SpvDiagnosticList& log)
+    {
+        if (log.GetCount() > 0)
+        {
+            diagnostics.Append(log);
+            logFormatted = false;
+        }
+    }
+
+    // Add the info log of a parsed shader to SPV program log, it is only formatted when the log is queried
+    void AddCompileLog(
+        glslang::TShader* pShader)
+    {
+        AddStageLog(pShader->getInfoLog(), SpvDiagnosticList::PhaseCompile, pShader->getStage());
+        AddStageLog(pShader->getInfoDebugLog(), SpvDiagnosticList::PhaseCompile, pShader->getStage());
+    }
+
+    // Add the link log of current program to SPV program log
+    void AddLinkLog()
+    {
+        AddLinkLog(GetCurrentProgram());
+    }
+
+    // Add the link log of a program to SPV program log, the stages are taken from its "Linked <stage> stage:" headers
+    void AddLinkLog(
+        glslang::TProgram* pLinkProgram)
+    {
+        AddStageLog(pLinkProgram->getInfoLog(), SpvDiagnosticList::PhaseLink, EShLangCount);
+        AddStageLog(pLinkProgram->getInfoDebugLog(), SpvDiagnosticList::PhaseLink, EShLangCount);
+    }
+
+    // Add the info log of a compile step to SPV program log
+    void AddStageLog(
+        const char*              pLog,
+        SpvDiagnosticList::Phase phase,
+        EShLanguage              stage)   // Stage of the log, EShLangCount if it has none
+    {
+        if (pLog[0] != '\0')
+        {
+            diagnostics.AddLog(pLog, phase, EShLanguageToSpvGenStage(stage));
+            logFormatted = false;
         }
+    }
 
-        for (int i = 0; i < EShLangCount; ++i)
+    // Remove all entries of SPV program log
+    void ClearLog()
+    {
+        diagnostics.Clear();
+        logFormatted = false;
+    }
+
+    // Get SPV program log, it is formatted from the diagnostics on first use
+    const char* GetLog()
+    {
+        std::lock_guard<std::mutex> guard(logLock);
+        if (logFormatted == false)
         {
-            if ((infoEntry[i] != nullptr) && (strlen(infoEntry[i]) > 0))
-            {
-                sprintf(buffer, "Linking %s stage:\n", glslang::StageName((EShLanguage)i));
-                formatedString += buffer;
-                formatedString += infoEntry[i];
-            }
+            diagnostics.Format(&programLog);
+            logFormatted = true;
         }
-        delete[] pInfoCopy;
+        return programLog.c_str();
+    }
+
+    // Get the log returned by the compile entry-points, it is empty if formatting is deferred by the options
+    const char* GetCompileLog(
+        int options)
+    {
+        return ((options & SpvGenOptionDeferLog) != 0) ? "" : GetLog();
+    }
+
+    // Get the diagnostics of SPV program log, they are parsed when the info logs are added
+    const SpvDiagnosticList& GetDiagnostics() const
+    {
+        return diagnostics;
     }
 
     // Get current program
@@ -729,9 +1076,30 @@ public:
         programs.push_back(new glslang::TProgram);
     }
 
-    std::string                             programLog;
+    SpvDiagnosticList                       diagnostics;           // Parsed info logs of all compile steps
+    std::mutex                              logLock;               // Protects the formatting on demand
+    std::string                             programLog;            // Formatted log, valid if logFormatted is set
+    bool                                    logFormatted = true;
     std::vector<glslang::TProgram*>         programs;
     std::vector<std::vector<unsigned int> > spirvs;
+    std::vector<SpvCompileStageStats>       stageStats;
+
+    // Source of a retained stage, spvRecompileProgramStage parses the stages of a link group again from it
+    struct SpvStageSource
+    {
+        std::vector<std::string> strings;         // Source strings
+        std::vector<std::string> fileNames;       // File names of the source strings, empty if there are none
+        std::string              entryPoint;
+        bool                     hasEntryPoint;
+    };
+
+    // Only filled if the program is compiled with SpvGenOptionRetainShaders
+    std::vector<SpvStageSource>             stageSources;     // Source of each stage
+    std::vector<SpvGenStage>                stageTypes;       // Type of each stage
+    std::vector<int>                        linkGroups;       // Link group of each stage, -1 if it has no source
+    int                                     options = 0;      // Options of the initial compile
+    std::string                             preamble;         // Preamble of the initial compile
+    TBuiltInResource                        resources = {};   // Resource limits of the initial compile
 };
 
 // =====================================================================================================================
@@ -747,7 +1115,7 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramFromFile(
                                               nullptr,
                                               ppProgram,
                                               ppLog,
-                                              DefaultOptions);
+                                              DefaultContext.defaultOptions);
 }
 
 // =====================================================================================================================
@@ -759,6 +1127,27 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramFromFileEx(
     void**          ppProgram,
     const char**    ppLog,
     int             options)
+{
+    return spvCompileAndLinkProgramFromFileExWithContext(nullptr,
+                                                         fileNum,
+                                                         fileList,
+                                                         entryPoints,
+                                                         ppProgram,
+                                                         ppLog,
+                                                         options);
+}
+
+// =====================================================================================================================
+// Compile and link GLSL source from file list with full parameters, using the specified context. The process-wide
+// context is used if hContext is null.
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramFromFileExWithContext(
+    void*           hContext,
+    int             fileNum,
+    const char*     fileList[],
+    const char*     entryPoints[],
+    void**          ppProgram,
+    const char**    ppLog,
+    int             options)
 {
     std::vector<std::string> sources(fileNum);
     std::vector<SpvGenStage> stageTypes(fileNum);
@@ -771,7 +1160,7 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramFromFileEx(
     for (int i = 0; i < fileNum; ++i)
     {
         stageTypes[i] = spvGetStageTypeFromName(fileList[i], &isHlsl);
-        if (ReadFileData(fileList[i], sources[i]))
+        if (ReadFileData(fileList[i], sources[i]) == false)
         {
             return false;
         }
@@ -789,156 +1178,426 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramFromFileEx(
     {
         options |= SpvGenOptionReadHlsl;
     }
-    return spvCompileAndLinkProgramEx(fileNum,
-                                      &stageTypes[0],
-                                      &sourceCount[0],
-                                      &sourceListPtr[0],
-                                      &fileListPtr[0],
-                                      entryPoints,
-                                      ppProgram,
-                                      ppLog,
-                                      options);
+    return spvCompileAndLinkProgramExWithContext(hContext,
+                                                 fileNum,
+                                                 &stageTypes[0],
+                                                 &sourceCount[0],
+                                                 &sourceListPtr[0],
+                                                 &fileListPtr[0],
+                                                 entryPoints,
+                                                 ppProgram,
+                                                 ppLog,
+                                                 options);
 }
 
 // =====================================================================================================================
-// Compile and link GLSL source strings, and the result is stored in pProgram
-bool SH_IMPORT_EXPORT spvCompileAndLinkProgram(
-    int                  shaderStageSourceCounts[SpvGenNativeStageCount],
-    const char* const *  shaderStageSources[SpvGenNativeStageCount],
-    void**               ppProgram,
-    const char**         ppLog)
+// Compile and link several entry-points of one source file, e.g. the vertex, pixel and compute shaders of an HLSL
+// effect file. The file is read once, and preprocessed once per distinct stage, since the predefined macros and the
+// extension behavior depend on the stage. Entry-points of the same stage share the preprocessed text. The stages are
+// preprocessed and compiled concurrently, and linked like the stages of spvCompileAndLinkProgramFromFileEx. The
+// process-wide context is used if hContext is null.
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEntryPointsFromFile(
+    void*              hContext,          // [in] Compiler context, may be null
+    const char*        pFileName,         // [in] Source file
+    int                entryPointCount,   // Number of entry-points
+    const SpvGenStage* stageList,         // [in] Stage of each entry-point
+    const char*        entryPoints[],     // [in] Name of each entry-point
+    void**             ppProgram,         // [out] Compiled program, one stage per entry-point
+    const char**       ppLog,             // [out] Compile and link log
+    int                options)           // Compile options
 {
-    static const SpvGenStage stageTypes[SpvGenNativeStageCount] =
+    SpvContext* pContext = (hContext != nullptr) ? reinterpret_cast<SpvContext*>(hContext) : &DefaultContext;
+    bool isHlsl = false;
+    spvGetStageTypeFromName(pFileName, &isHlsl);
+    if (isHlsl)
     {
-        SpvGenStageTask,
-        SpvGenStageVertex,
-        SpvGenStageTessControl,
-        SpvGenStageTessEvaluation,
-        SpvGenStageGeometry,
-        SpvGenStageMesh,
-        SpvGenStageFragment,
-        SpvGenStageCompute,
-    };
-    static const char* const* fileList[SpvGenNativeStageCount] = {};
-    return spvCompileAndLinkProgramEx(SpvGenNativeStageCount,
-                                     stageTypes,
-                                     shaderStageSourceCounts,
-                                     shaderStageSources,
-                                     fileList,
-                                     nullptr,
-                                     ppProgram,
-                                     ppLog,
-                                     DefaultOptions);
-}
+        options |= SpvGenOptionReadHlsl;
+    }
 
-// =====================================================================================================================
-// Compile and link GLSL source strings with full parameters
-bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEx(
-    int                  stageCount,
-    const SpvGenStage*   stageTypeList,
-    const int*           shaderStageSourceCounts,
-    const char* const *  shaderStageSources[],
-    const char* const *  fileList[],
-    const char*          entryPoints[],
-    void**               ppProgram,
-    const char**         ppLog,
-    int                  options)
-{
-    // Set the version of the input semantics.
-    const int ClientInputSemanticsVersion = 100;
+    *ppProgram = nullptr;
+    *ppLog = "";
+    std::string source;
+    if ((entryPointCount <= 0) || (ReadFileData(pFileName, source) == false))
+    {
+        return false;
+    }
+
+    // Index of the entry-point whose preprocessed text each entry-point uses, the first one of its stage
+    std::vector<int> preprocessIndices(entryPointCount);
+    for (int i = 0; i < entryPointCount; ++i)
+    {
+        preprocessIndices[i] = i;
+        for (int j = 0; j < i; ++j)
+        {
+            if (stageList[j] == stageList[i])
+            {
+                preprocessIndices[i] = j;
+                break;
+            }
+        }
+    }
 
     EShMessages messages = EShMsgDefault;
     SetMessageOptions(messages, options);
+    const char* pSource = source.c_str();
+    std::vector<std::unique_ptr<glslang::TShader>> shaders(entryPointCount);
+    std::vector<std::string> preprocessed(entryPointCount);
+    std::unique_ptr<bool[]> preprocessResults(new bool[entryPointCount]());
+    SpvTaskGroup preprocessGroup(SpvThreadPool::GetDefault());
+    for (int i = 0; i < entryPointCount; ++i)
+    {
+        if (preprocessIndices[i] == i)
+        {
+            shaders[i].reset(CreateShader(stageList[i], 1, &pSource, &pFileName, entryPoints[i], nullptr, options));
+            preprocessGroup.Run([&, i]()
+                {
+                    SpvCachedFileIncluder includer;
+                    preprocessResults[i] = shaders[i]->preprocess(&pContext->resources,
+                                                                  (options & SpvGenOptionDefaultDesktop) ? 110 : 100,
+                                                                  ENoProfile,
+                                                                  false,
+                                                                  false,
+                                                                  messages,
+                                                                  &preprocessed[i],
+                                                                  includer);
+                });
+        }
+    }
+    preprocessGroup.Wait();
 
-    bool compileFailed = false;
-    bool linkFailed = false;
+    bool success = true;
+    for (int i = 0; i < entryPointCount; ++i)
+    {
+        success = success && ((shaders[i] == nullptr) || preprocessResults[i]);
+    }
+    if (success == false)
+    {
+        SpvProgram* pProgram = new SpvProgram(entryPointCount);
+        for (int i = 0; i < entryPointCount; ++i)
+        {
+            if (shaders[i] != nullptr)
+            {
+                pProgram->AddCompileLog(shaders[i].get());
+            }
+        }
+        *ppProgram = pProgram;
+        *ppLog = pProgram->GetCompileLog(options);
+        return false;
+    }
+    shaders.clear();
 
-    SpvProgram* pProgram = new SpvProgram(stageCount);
-    *ppProgram = pProgram;
+    std::vector<const char*>        preprocessedTexts(entryPointCount);
+    std::vector<int>                sourceCounts(entryPointCount, 1);
+    std::vector<const char* const*> sourceLists(entryPointCount);
+    std::vector<const char* const*> fileLists(entryPointCount, &pFileName);
+    for (int i = 0; i < entryPointCount; ++i)
+    {
+        preprocessedTexts[i] = preprocessed[preprocessIndices[i]].c_str();
+        sourceLists[i] = &preprocessedTexts[i];
+    }
+    return spvCompileAndLinkProgramExWithContext(hContext,
+                                                 entryPointCount,
+                                                 stageList,
+                                                 sourceCounts.data(),
+                                                 sourceLists.data(),
+                                                 fileLists.data(),
+                                                 entryPoints,
+                                                 ppProgram,
+                                                 ppLog,
+                                                 options);
+}
 
-    uint32_t stageMask = 0;
-    std::vector<glslang::TShader*> shaders(stageCount);
-    for (int i = 0, linkIndexBase = 0; i < stageCount; ++i)
+// =====================================================================================================================
+// Compile and link GLSL source strings, and the result is stored in pProgram
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgram(
+    int                  shaderStageSourceCounts[SpvGenNativeStageCount],
+    const char* const *  shaderStageSources[SpvGenNativeStageCount],
+    void**               ppProgram,
+    const char**         ppLog)
+{
+    return spvCompileAndLinkProgramWithContext(nullptr, shaderStageSourceCounts, shaderStageSources, ppProgram, ppLog);
+}
+
+// =====================================================================================================================
+// Compile and link GLSL source strings with the default options of the specified context, and the result is stored in
+// pProgram. The process-wide context is used if hContext is null.
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramWithContext(
+    void*                hContext,
+    int                  shaderStageSourceCounts[SpvGenNativeStageCount],
+    const char* const *  shaderStageSources[SpvGenNativeStageCount],
+    void**               ppProgram,
+    const char**         ppLog)
+{
+    const SpvContext* pContext =
+        (hContext != nullptr) ? reinterpret_cast<const SpvContext*>(hContext) : &DefaultContext;
+    static const SpvGenStage stageTypes[SpvGenNativeStageCount] =
     {
-        if (shaderStageSourceCounts[i] > 0)
+        SpvGenStageTask,
+        SpvGenStageVertex,
+        SpvGenStageTessControl,
+        SpvGenStageTessEvaluation,
+        SpvGenStageGeometry,
+        SpvGenStageMesh,
+        SpvGenStageFragment,
+        SpvGenStageCompute,
+    };
+    static const char* const* fileList[SpvGenNativeStageCount] = {};
+    return spvCompileAndLinkProgramExWithContext(hContext,
+                                                 SpvGenNativeStageCount,
+                                                 stageTypes,
+                                                 shaderStageSourceCounts,
+                                                 shaderStageSources,
+                                                 fileList,
+                                                 nullptr,
+                                                 ppProgram,
+                                                 ppLog,
+                                                 pContext->defaultOptions);
+}
+
+// =====================================================================================================================
+// Hash all inputs which affect the result of a compile, returns false if the compile can't be cached
+//
+// NOTE: A stage which uses #include is preprocessed, and its preprocessed source is hashed too, so that the key covers
+// the content of the included files. The include files are read through the process-wide include cache, so the parse
+// of a compile which misses the cache doesn't read them again. A stage which fails to preprocess isn't cached.
+bool HashCompileInput(
+    int                     stageCount,
+    const SpvGenStage*      stageTypeList,
+    const int*              shaderStageSourceCounts,
+    const char* const *     shaderStageSources[],
+    const char* const *     fileList[],
+    const char*             entryPoints[],
+    const char*             pPreamble,
+    int                     options,
+    const TBuiltInResource* pResources,
+    SpvHash128*             pHash)
+{
+    EShMessages messages = EShMsgDefault;
+    SetMessageOptions(messages, options);
+
+    // Deferring the log doesn't change the result, the cache keeps the diagnostics either way
+    SpvHasher hasher;
+    hasher.Update(options & ~SpvGenOptionDeferLog);
+    hasher.Update(stageCount);
+
+    for (int i = 0; i < stageCount; ++i)
+    {
+        hasher.Update(shaderStageSourceCounts[i]);
+        if (shaderStageSourceCounts[i] <= 0)
         {
-            assert(shaderStageSources[i] != nullptr);
-            assert(stageTypeList[i] < SpvGenStageCount);
-            EShLanguage stage = SpvGenStageToEShLanguage(stageTypeList[i]);
+            continue;
+        }
 
-            // Per-shader processing...
-            glslang::TShader* pShader = new glslang::TShader(stage);
-            shaders[i] = pShader;
+        hasher.Update(stageTypeList[i]);
+        hasher.UpdateString((entryPoints != nullptr) ? entryPoints[i] : nullptr);
+        bool hasInclude = false;
+        for (int j = 0; j < shaderStageSourceCounts[i]; ++j)
+        {
+            const char* pSource = shaderStageSources[i][j];
+            hasInclude = hasInclude || (strstr(pSource, "#include") != nullptr);
+            hasher.UpdateString(pSource);
+            hasher.UpdateString(((fileList != nullptr) && (fileList[i] != nullptr)) ? fileList[i][j] : nullptr);
+        }
 
-            if (fileList == nullptr || fileList[i] == nullptr)
-            {
-                pShader->setStrings(shaderStageSources[i], shaderStageSourceCounts[i]);
-            }
-            else
+        if (hasInclude)
+        {
+            std::unique_ptr<glslang::TShader> pShader(
+                CreateShader(stageTypeList[i],
+                             shaderStageSourceCounts[i],
+                             shaderStageSources[i],
+                             (fileList == nullptr) ? nullptr : fileList[i],
+                             (entryPoints == nullptr) ? nullptr : entryPoints[i],
+                             pPreamble,
+                             options));
+            SpvCachedFileIncluder includer;
+            std::string preprocessed;
+            if (pShader->preprocess(pResources,
+                                    (options & SpvGenOptionDefaultDesktop) ? 110 : 100,
+                                    ENoProfile,
+                                    false,
+                                    false,
+                                    messages,
+                                    &preprocessed,
+                                    includer) == false)
             {
-                pShader->setStringsWithLengthsAndNames(shaderStageSources[i], nullptr, fileList[i], shaderStageSourceCounts[i]);
+                return false;
             }
+            hasher.UpdateString(preprocessed.c_str());
+        }
+    }
 
-            if (options & SpvGenOptionVulkanRules)
-            {
-                pShader->setEnvInput((options & SpvGenOptionReadHlsl) ? glslang::EShSourceHlsl : glslang::EShSourceGlsl,
-                                    stage,
-                                    glslang::EShClientVulkan,
-                                    ClientInputSemanticsVersion);
-                pShader->setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
-            }
-            else
-            {
-                assert((options & SpvGenOptionReadHlsl) == 0); // Assume OGL don't use HLSL
-                pShader->setEnvInput((options & SpvGenOptionReadHlsl) ? glslang::EShSourceHlsl : glslang::EShSourceGlsl,
-                                    stage,
-                                    glslang::EShClientOpenGL,
-                                    ClientInputSemanticsVersion);
-                pShader->setEnvClient(glslang::EShClientOpenGL, glslang::EShTargetOpenGL_450);
-            }
+    // Resource limits, the trailing padding of the structure is skipped
+    hasher.Update(pResources, offsetof(TBuiltInResource, limits));
+    hasher.Update(pResources->limits.nonInductiveForLoops);
+    hasher.Update(pResources->limits.whileLoops);
+    hasher.Update(pResources->limits.doWhileLoops);
+    hasher.Update(pResources->limits.generalUniformIndexing);
+    hasher.Update(pResources->limits.generalAttributeMatrixVectorIndexing);
+    hasher.Update(pResources->limits.generalVaryingIndexing);
+    hasher.Update(pResources->limits.generalSamplerIndexing);
+    hasher.Update(pResources->limits.generalVariableIndexing);
+    hasher.Update(pResources->limits.generalConstantMatrixVectorIndexing);
+
+    // Only hashed if present, so that the keys of programs without a preamble stay the same
+    if ((pPreamble != nullptr) && (pPreamble[0] != '\0'))
+    {
+        hasher.UpdateString(pPreamble);
+    }
+
+    *pHash = hasher.Finalize();
+    return true;
+}
 
-            pShader->setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_6);
+// =====================================================================================================================
+// Get the link group of each stage. Consecutive stages are linked together, a new link group starts at a stage whose
+// type is already in the current group. Stages without source get -1.
+static void GetLinkGroups(
+    int                  stageCount,
+    const SpvGenStage*   stageTypeList,
+    const int*           shaderStageSourceCounts,
+    std::vector<int>*    pLinkGroups)   // [out] Link group of each stage
+{
+    pLinkGroups->resize(stageCount);
 
-            if (entryPoints && entryPoints[i])
+    int linkGroup = 0;
+    uint32_t stageMask = 0;
+    for (int i = 0; i < stageCount; ++i)
+    {
+        if (shaderStageSourceCounts[i] > 0)
+        {
+            if (stageMask & (1 << stageTypeList[i]))
             {
-                pShader->setEntryPoint(entryPoints[i]);
+                ++linkGroup;
+                stageMask = 0;
             }
+            stageMask |= (1 << stageTypeList[i]);
+            (*pLinkGroups)[i] = linkGroup;
+        }
+        else
+        {
+            (*pLinkGroups)[i] = -1;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Compile and link GLSL source strings with full parameters
+//
+// NOTE: The stages are parsed concurrently on the worker thread pool, linking and SPIR-V generation happen in stage
+// order afterwards, so the result and the log don't depend on the parse order.
+bool CompileAndLinkProgram(
+    const TBuiltInResource* pResources,
+    int                     stageCount,
+    const SpvGenStage*      stageTypeList,
+    const int*              shaderStageSourceCounts,
+    const char* const *     shaderStageSources[],
+    const char* const *     fileList[],
+    const char*             entryPoints[],
+    const char*             pPreamble,
+    void**                  ppProgram,
+    const char**            ppLog,
+    int                     options)
+{
+    EShMessages messages = EShMsgDefault;
+    SetMessageOptions(messages, options);
+
+    bool compileFailed = false;
+    bool linkFailed = false;
+
+    SpvProgram* pProgram = new SpvProgram(stageCount);
+    *ppProgram = pProgram;
+
+    // Create all shaders up front, they are independent from each other until link time.
+    uint32_t parseCount = 0;
+    std::vector<glslang::TShader*> shaders(stageCount);
+    std::unique_ptr<bool[]> parseResults(new bool[stageCount]());
+    for (int i = 0; i < stageCount; ++i)
+    {
+        if (shaderStageSourceCounts[i] > 0)
+        {
+            assert(shaderStageSources[i] != nullptr);
+            assert(stageTypeList[i] < SpvGenStageCount);
 
             if ((options & SpvGenOptionFlattenUniformArrays) != 0 &&
                 (options & SpvGenOptionReadHlsl) == 0)
             {
+                for (int j = 0; j < i; ++j)
+                {
+                    delete shaders[j];
+                }
                 pProgram->AddLog("uniform array flattening only valid when compiling HLSL source.");
+                *ppLog = pProgram->GetCompileLog(options);
                 return false;
             }
 
-            pShader->setFlattenUniformArrays((options & SpvGenOptionFlattenUniformArrays) != 0);
+            shaders[i] = CreateShader(stageTypeList[i],
+                                      shaderStageSourceCounts[i],
+                                      shaderStageSources[i],
+                                      (fileList == nullptr) ? nullptr : fileList[i],
+                                      (entryPoints == nullptr) ? nullptr : entryPoints[i],
+                                      pPreamble,
+                                      options);
+            ++parseCount;
 
-            if (options & SpvGenOptionHlslIoMapping)
+            for (int j = 0; j < shaderStageSourceCounts[i]; ++j)
             {
-                pShader->setHlslIoMapping(true);
+                pProgram->stageStats[i].sourceSize += strlen(shaderStageSources[i][j]);
             }
+        }
+    }
 
-            if (options & SpvGenOptionAutoMapBindings)
+    // Per-shader processing... The stages of each link group are parsed by a task group of their own, so that a
+    // group can be linked as soon as its stages are parsed. Linking stays in stage order on this thread, while the
+    // SPIR-V of a linked group is generated on the pool, overlapped with the parsing and linking of the next ones.
+    const bool runConcurrently = (parseCount > 1);
+    std::vector<int> linkGroups;
+    GetLinkGroups(stageCount, stageTypeList, shaderStageSourceCounts, &linkGroups);
+    std::vector<std::unique_ptr<SpvTaskGroup>> parseGroups;
+    if (runConcurrently)
+    {
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (shaders[i] != nullptr)
             {
-                pShader->setAutoMapBindings(true);
+                const size_t linkGroup = static_cast<size_t>(linkGroups[i]);
+                while (parseGroups.size() <= linkGroup)
+                {
+                    parseGroups.emplace_back(new SpvTaskGroup(SpvThreadPool::GetDefault()));
+                }
+                parseGroups[linkGroup]->Run([&, i]()
+                    {
+                        parseResults[i] =
+                            ParseShader(shaders[i], messages, options, pResources, &pProgram->stageStats[i]);
+                    });
             }
-
-            if (options & SpvGenOptionAutoMapLocations)
+        }
+    }
+    else
+    {
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (shaders[i] != nullptr)
             {
-                pShader->setAutoMapLocations(true);
+                parseResults[i] = ParseShader(shaders[i], messages, options, pResources, &pProgram->stageStats[i]);
             }
+        }
+    }
 
-            if (options & SpvGenOptionInvertY)
+    SpvTaskGroup spirvGroup(SpvThreadPool::GetDefault());
+    std::atomic<bool> spirvFailed(false);
+
+    uint32_t stageMask = 0;
+    for (int i = 0, linkIndexBase = 0; i < stageCount; ++i)
+    {
+        if (shaders[i] != nullptr)
+        {
+            if (runConcurrently)
             {
-                pShader->setInvertY(true);
+                parseGroups[linkGroups[i]]->Wait();
             }
 
-            DirStackFileIncluder includer;
-            compileFailed = !pShader->parse(&Resources,
-                (options & SpvGenOptionDefaultDesktop) ? 110 : 100,
-                false,
-                messages,
-                includer);
+            glslang::TShader* pShader = shaders[i];
+            compileFailed = (parseResults[i] == false);
 
             if (compileFailed == false)
             {
@@ -948,16 +1607,7 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEx(
 
             if ((options & SpvGenOptionSuppressInfolog) == false)
             {
-                const char* pInfoLog = pShader->getInfoLog();
-                const char* pDebugLog = pShader->getInfoDebugLog();
-                if ((strlen(pInfoLog) > 0) || (strlen(pDebugLog) > 0))
-                {
-                    char buffer[256];
-                    sprintf(buffer, "Compiling %s stage:\n", glslang::StageName(stage));
-                    pProgram->AddLog(buffer);
-                    pProgram->AddLog(pShader->getInfoLog());
-                    pProgram->AddLog(pShader->getInfoDebugLog());
-                }
+                pProgram->AddCompileLog(pShader);
             }
         }
 
@@ -976,31 +1626,39 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEx(
                 }
             }
 
+            if (doLink && SpvMemoryTracker::IsCurrentBudgetExceeded())
+            {
+                // The memory budget of the call is exceeded, the remaining link groups are skipped
+                linkFailed = true;
+                break;
+            }
+
             if (doLink)
             {
                 // Program-level processing...
+                auto startTime = std::chrono::steady_clock::now();
                 linkFailed = !pProgram->link(messages);
+                const uint64_t linkTime = GetElapsedTime(startTime);
 
                 // Map IO, consistent with glslangValidator StandAlone: https://github.com/KhronosGroup/glslang/blob/master/StandAlone/StandAlone.cpp line 1138
+                startTime = std::chrono::steady_clock::now();
                 linkFailed = !pProgram->mapIO();
+                const uint64_t mapIoTime = GetElapsedTime(startTime);
+
+                for (int linkIndex = linkIndexBase; linkIndex <= i; ++linkIndex)
+                {
+                    pProgram->stageStats[linkIndex].linkTime = linkTime;
+                    pProgram->stageStats[linkIndex].mapIoTime = mapIoTime;
+                }
 
                 if ((options & SpvGenOptionSuppressInfolog) == false)
                 {
-                    const char* pInfoLog = pProgram->getInfoLog();
-                    const char* pDebugLog = pProgram->getInfoDebugLog();
-                    std::string formatLog;
-                    pProgram->FormatLinkInfo(pInfoLog, formatLog);
-                    if (formatLog.size() > 0 || strlen(pDebugLog) > 0)
-                    {
-                        pProgram->AddLog(formatLog.c_str());
-                        pProgram->AddLog(pDebugLog);
-                    }
+                    pProgram->AddLinkLog();
                 }
 
                 if (linkFailed)
                 {
-                    *ppLog = pProgram->programLog.c_str();
-                    return false;
+                    break;
                 }
 
                 for (int linkIndex = linkIndexBase; linkIndex <= i; ++linkIndex)
@@ -1008,12 +1666,27 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEx(
                     if (shaders[linkIndex] != nullptr)
                     {
                         EShLanguage linkStage = shaders[linkIndex]->getStage();
-                        auto pIntermediate = pProgram->getIntermediate(linkStage);
-                        glslang::SpvOptions spvOptions = {};
-                        spvOptions.generateDebugInfo = (options & SpvGenOptionDebug) != 0;
-                        spvOptions.disableOptimizer = (options & SpvGenOptionOptimizeDisable) != 0;
-                        spvOptions.optimizeSize = (options & SpvGenOptionOptimizeSize) != 0;
-                        glslang::GlslangToSpv(*pIntermediate, pProgram->spirvs[linkIndex], &spvOptions);
+                        const glslang::TIntermediate* pIntermediate = pProgram->getIntermediate(linkStage);
+                        std::vector<unsigned int>* pSpirv = &pProgram->spirvs[linkIndex];
+                        SpvCompileStageStats* pStats = &pProgram->stageStats[linkIndex];
+                        if (runConcurrently)
+                        {
+                            spirvGroup.Run([pIntermediate, options, pSpirv, pStats, &spirvFailed]()
+                                {
+                                    // The memory budget of the call is checked before the generation, never inside
+                                    if (SpvMemoryTracker::IsCurrentBudgetExceeded())
+                                    {
+                                        spirvFailed = true;
+                                        return;
+                                    }
+                                    SpvPoolAllocatorScope poolScope;
+                                    GenerateSpirv(*pIntermediate, options, pSpirv, pStats);
+                                });
+                        }
+                        else
+                        {
+                            GenerateSpirv(*pIntermediate, options, pSpirv, pStats);
+                        }
                     }
                 }
                 linkIndexBase = i + 1;
@@ -1023,440 +1696,2582 @@ bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEx(
         }
     }
 
+    // The shaders are released below, so all tasks must be finished first. Stages of groups which weren't linked
+    // because of an earlier failure may still be parsing.
+    spirvGroup.Wait();
+    for (auto& parseGroup : parseGroups)
+    {
+        parseGroup->Wait();
+    }
+
+    // A phase which exceeded the memory budget of the call ran to its end, the call fails now
+    linkFailed = linkFailed || spirvFailed || SpvMemoryTracker::IsCurrentBudgetExceeded();
+
+    if ((options & SpvGenOptionRetainShaders) != 0)
+    {
+        // Keep the sources for spvRecompileProgramStage, it parses the stages of a link group again from them
+        pProgram->stageSources.resize(stageCount);
+        for (int i = 0; i < stageCount; ++i)
+        {
+            SpvProgram::SpvStageSource& stageSource = pProgram->stageSources[i];
+            for (int j = 0; j < shaderStageSourceCounts[i]; ++j)
+            {
+                stageSource.strings.push_back(shaderStageSources[i][j]);
+                if ((fileList != nullptr) && (fileList[i] != nullptr))
+                {
+                    stageSource.fileNames.push_back(fileList[i][j]);
+                }
+            }
+            stageSource.hasEntryPoint = (entryPoints != nullptr) && (entryPoints[i] != nullptr);
+            stageSource.entryPoint = stageSource.hasEntryPoint ? entryPoints[i] : "";
+        }
+        pProgram->stageTypes.assign(stageTypeList, stageTypeList + stageCount);
+        pProgram->linkGroups = std::move(linkGroups);
+        pProgram->options = options;
+        pProgram->resources = *pResources;
+        pProgram->preamble = (pPreamble != nullptr) ? pPreamble : "";
+    }
+
     for (size_t i = 0; i < shaders.size(); ++i)
     {
         delete shaders[i];
     }
     shaders.clear();
 
-    *ppLog = pProgram->programLog.c_str();
+    *ppLog = pProgram->GetCompileLog(options);
     return (compileFailed || linkFailed) ? false : true;
 }
 
 // =====================================================================================================================
-// Destroies SpvProgram object
-void SH_IMPORT_EXPORT spvDestroyProgram(
-    void* hProgram)
+// Get the hash of the component versions reported by spvGetVersion, it is part of every persistent cache key
+SpvHash128 GetVersionKey()
 {
-    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
-    delete pProgram;
+    static const SpvHash128 VersionKey = []()
+    {
+        static const SpvGenVersion Components[] =
+        {
+            SpvGenVersionGlslang,
+            SpvGenVersionSpirv,
+            SpvGenVersionSpvGen,
+        };
+
+        SpvHasher hasher;
+        for (SpvGenVersion component : Components)
+        {
+            unsigned int version = 0;
+            unsigned int revision = 0;
+            spvGetVersion(component, &version, &revision);
+            hasher.Update(version);
+            hasher.Update(revision);
+        }
+        return hasher.Finalize();
+    }();
+
+    return VersionKey;
 }
 
 // =====================================================================================================================
-// Get SPRIV binary from OGLProgram object with specified shader stage, and return the binary size in bytes
+// Compile and link GLSL source strings with full parameters
 //
-// NOTE: 0 is returned if SPIRVI binary isn't exist for specified shader stage
-int SH_IMPORT_EXPORT spvGetSpirvBinaryFromProgram(
-    void*                hProgram,
-    int                  stage,
-    const unsigned int** ppData)
+// NOTE: If the in-memory or the on-disk compile cache is enabled, the result of a previous compile with identical
+// input is returned without running glslang, unless SpvGenOptionRetainShaders is specified.
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramEx(
+    int                  stageCount,
+    const SpvGenStage*   stageTypeList,
+    const int*           shaderStageSourceCounts,
+    const char* const *  shaderStageSources[],
+    const char* const *  fileList[],
+    const char*          entryPoints[],
+    void**               ppProgram,
+    const char**         ppLog,
+    int                  options)
 {
-    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
-    int programSize = (int)(pProgram->spirvs[stage].size() * sizeof(unsigned int));
-    if (programSize > 0)
-    {
-        *ppData = &pProgram->spirvs[stage][0];
-    }
-    else
-    {
-        *ppData = nullptr;
-    }
-    return programSize;
+    return spvCompileAndLinkProgramExWithContext(nullptr,
+                                                 stageCount,
+                                                 stageTypeList,
+                                                 shaderStageSourceCounts,
+                                                 shaderStageSources,
+                                                 fileList,
+                                                 entryPoints,
+                                                 ppProgram,
+                                                 ppLog,
+                                                 options);
 }
 
 // =====================================================================================================================
-// Deduce the language from the filename.  Files must end in one of the following extensions:
-SpvGenStage SH_IMPORT_EXPORT spvGetStageTypeFromName(
-    const char* pName,
-    bool*       pIsHlsl)
+// Compile and link a program with the resource limits of a context, the result is taken from the compile caches of the
+// context if possible.
+bool CompileAndLinkProgramCached(
+    SpvContext*          pContext,
+    int                  stageCount,
+    const SpvGenStage*   stageTypeList,
+    const int*           shaderStageSourceCounts,
+    const char* const *  shaderStageSources[],
+    const char* const *  fileList[],
+    const char*          entryPoints[],
+    const char*          pPreamble,
+    void**               ppProgram,
+    const char**         ppLog,
+    int                  options)
 {
-    std::string name = pName;
-    size_t ext = name.rfind('.');
-    if (ext == std::string::npos)
-    {
-        return SpvGenStageInvalid;
-    }
+    std::shared_ptr<SpvCompileCache> pCache = std::atomic_load(&pContext->pCompileCache);
+    std::shared_ptr<SpvDiskCache> pDiskCache = std::atomic_load(&pContext->pCompileDiskCache);
+    SpvHash128 cacheKey = {};
+    SpvHash128 diskCacheKey = {};
+    // A cached program skips the compile which records the stage sources for spvRecompileProgramStage
+    bool cacheable = ((pCache != nullptr) || (pDiskCache != nullptr)) &&
+                     ((options & SpvGenOptionRetainShaders) == 0) &&
+                     HashCompileInput(stageCount,
+                                      stageTypeList,
+                                      shaderStageSourceCounts,
+                                      shaderStageSources,
+                                      fileList,
+                                      entryPoints,
+                                      pPreamble,
+                                      options,
+                                      &pContext->resources,
+                                      &cacheKey);
 
-    std::string suffix = name.substr(ext + 1, std::string::npos);
-    if (suffix == "glsl" || suffix == "hlsl")
+    if (cacheable)
     {
-        if (suffix == "hlsl")
+        std::shared_ptr<const SpvCompileCacheEntry> pEntry;
+        if (pCache != nullptr)
         {
-            *pIsHlsl = true;
+            pEntry = pCache->Find(cacheKey);
         }
 
-        // for .vert.glsl, .tesc.glsl, ..., .comp.glsl/.hlsl compound suffixes
-        name = name.substr(0, ext);
-        ext = name.rfind('.');
-        if (ext == std::string::npos) {
-            return SpvGenStageInvalid;
-        }
-        suffix = name.substr(ext + 1, std::string::npos);
+        if ((pEntry == nullptr) && (pDiskCache != nullptr))
+        {
+            SpvHasher hasher;
+            hasher.Update(cacheKey);
+            hasher.Update(GetVersionKey());
+            diskCacheKey = hasher.Finalize();
+
+            std::shared_ptr<SpvCompileCacheEntry> pDiskEntry = std::make_shared<SpvCompileCacheEntry>();
+            if (pDiskCache->Find(diskCacheKey, pDiskEntry.get()) &&
+                (pDiskEntry->spirvs.size() == static_cast<size_t>(stageCount)))
+            {
+                pEntry = pDiskEntry;
+                if (pCache != nullptr)
+                {
+                    pCache->Insert(cacheKey, pEntry);
+                }
+            }
+        }
+
+        if (pEntry != nullptr)
+        {
+            SpvProgram* pProgram = new SpvProgram(stageCount);
+            pProgram->spirvs = pEntry->spirvs;
+            pProgram->AddLog(pEntry->diagnostics);
+            for (int i = 0; i < stageCount; ++i)
+            {
+                pProgram->stageStats[i].cached = true;
+                pProgram->stageStats[i].spirvWordCount = static_cast<uint32_t>(pProgram->spirvs[i].size());
+                pProgram->stageStats[i].optimizedWordCount = pProgram->stageStats[i].spirvWordCount;
+            }
+            *ppProgram = pProgram;
+            *ppLog = pProgram->GetCompileLog(options);
+            return true;
+        }
+    }
+
+    bool success = CompileAndLinkProgram(&pContext->resources,
+                                         stageCount,
+                                         stageTypeList,
+                                         shaderStageSourceCounts,
+                                         shaderStageSources,
+                                         fileList,
+                                         entryPoints,
+                                         pPreamble,
+                                         ppProgram,
+                                         ppLog,
+                                         options);
+
+    if (success && cacheable)
+    {
+        SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(*ppProgram);
+        std::shared_ptr<SpvCompileCacheEntry> pEntry = std::make_shared<SpvCompileCacheEntry>();
+        pEntry->spirvs = pProgram->spirvs;
+        pEntry->diagnostics = pProgram->GetDiagnostics();
+        if (pDiskCache != nullptr)
+        {
+            pDiskCache->Store(diskCacheKey, *pEntry);
+        }
+        if (pCache != nullptr)
+        {
+            pCache->Insert(cacheKey, std::move(pEntry));
+        }
+    }
+
+    return success;
+}
+
+// =====================================================================================================================
+// Publish the memory statistics of a finished call for spvGetLastMemoryStats
+static void PublishMemoryStats(
+    const SpvMemoryTracker& tracker)   // [in] Tracker of the call
+{
+    LastMemoryStats.peakBytes = tracker.GetPeakBytes();
+    LastMemoryStats.totalBytes = tracker.GetTotalBytes();
+    LastMemoryStats.budgetExceeded = tracker.IsBudgetExceeded();
+    LastMemoryStats.heapTracked = SpvMemoryTracker::HasAllocationHooks();
+    LastMemoryStats.valid = true;
+}
+
+// =====================================================================================================================
+// Compile and link a program with the resource limits and the compile caches of a context, the memory allocated by the
+// compile is accounted for spvGetLastMemoryStats. If the memory budget of the calling thread is exceeded, the compile
+// is aborted and fails with an error in the log.
+static bool CompileAndLinkProgramTracked(
+    SpvContext*          pContext,
+    int                  stageCount,
+    const SpvGenStage*   stageTypeList,
+    const int*           shaderStageSourceCounts,
+    const char* const *  shaderStageSources[],
+    const char* const *  fileList[],
+    const char*          entryPoints[],
+    const char*          pPreamble,
+    void**               ppProgram,
+    const char**         ppLog,
+    int                  options)
+{
+    SpvMemoryTracker tracker(ThreadMemoryBudget);
+    bool success = false;
+    *ppProgram = nullptr;
+    {
+        SpvMemoryScope memoryScope(&tracker);
+        success = CompileAndLinkProgramCached(pContext,
+                                              stageCount,
+                                              stageTypeList,
+                                              shaderStageSourceCounts,
+                                              shaderStageSources,
+                                              fileList,
+                                              entryPoints,
+                                              pPreamble,
+                                              ppProgram,
+                                              ppLog,
+                                              options);
+
+        if (tracker.IsBudgetExceeded())
+        {
+            if (*ppProgram == nullptr)
+            {
+                *ppProgram = new SpvProgram(stageCount);
+            }
+            SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(*ppProgram);
+            char buffer[128];
+            Snprintf(buffer,
+                     sizeof(buffer),
+                     "error: memory budget of %llu bytes exceeded, the compile was aborted\n",
+                     static_cast<unsigned long long>(tracker.GetBudget()));
+            pProgram->AddLog(buffer);
+            *ppLog = pProgram->GetCompileLog(options);
+            success = false;
+        }
+    }
+    PublishMemoryStats(tracker);
+
+    return success;
+}
+
+// =====================================================================================================================
+// Compile and link GLSL source strings with full parameters, using the resource limits and the compile caches of the
+// specified context. The process-wide context is used if hContext is null.
+//
+// NOTE: The memory allocated by the call is accounted for spvGetLastMemoryStats. If the memory budget of the calling
+// thread is exceeded, the compile is aborted and fails with an error in the log.
+bool SH_IMPORT_EXPORT spvCompileAndLinkProgramExWithContext(
+    void*                hContext,
+    int                  stageCount,
+    const SpvGenStage*   stageTypeList,
+    const int*           shaderStageSourceCounts,
+    const char* const *  shaderStageSources[],
+    const char* const *  fileList[],
+    const char*          entryPoints[],
+    void**               ppProgram,
+    const char**         ppLog,
+    int                  options)
+{
+    SpvContext* pContext = (hContext != nullptr) ? reinterpret_cast<SpvContext*>(hContext) : &DefaultContext;
+    return CompileAndLinkProgramTracked(pContext,
+                                        stageCount,
+                                        stageTypeList,
+                                        shaderStageSourceCounts,
+                                        shaderStageSources,
+                                        fileList,
+                                        entryPoints,
+                                        nullptr,
+                                        ppProgram,
+                                        ppLog,
+                                        options);
+}
+
+// =====================================================================================================================
+// Create a shader from the retained source of a stage of a program, it isn't parsed yet
+static glslang::TShader* CreateRetainedShader(
+    const SpvProgram* pProgram,     // [in] Program compiled with SpvGenOptionRetainShaders
+    int               stageIndex)   // Index of the stage in the stage list of the initial compile
+{
+    const SpvProgram::SpvStageSource& stageSource = pProgram->stageSources[stageIndex];
+    std::vector<const char*> strings;
+    std::vector<const char*> fileNames;
+    for (const std::string& string : stageSource.strings)
+    {
+        strings.push_back(string.c_str());
+    }
+    for (const std::string& fileName : stageSource.fileNames)
+    {
+        fileNames.push_back(fileName.c_str());
+    }
+
+    return CreateShader(pProgram->stageTypes[stageIndex],
+                        static_cast<int>(strings.size()),
+                        strings.data(),
+                        fileNames.empty() ? nullptr : fileNames.data(),
+                        stageSource.hasEntryPoint ? stageSource.entryPoint.c_str() : nullptr,
+                        pProgram->preamble.c_str(),
+                        pProgram->options);
+}
+
+// =====================================================================================================================
+// Replace the source of one stage of a program compiled with SpvGenOptionRetainShaders, see spvRecompileProgramStage.
+// The link group of the stage is parsed from source and linked into a program of its own, the glslang objects of the
+// call are released before it returns. SPV program is only updated if the call succeeds.
+static bool RecompileProgramStage(
+    SpvProgram*          pProgram,            // [in] Program compiled with SpvGenOptionRetainShaders
+    int                  stageIndex,          // Index of the stage in the stage list of the initial compile
+    int                  sourceStringCount,   // Number of source strings of the stage
+    const char* const*   sourceList,          // [in] Source strings of the stage
+    const char* const*   fileList,            // [in] File names of the source strings, may be null
+    const char*          entryPoint)          // [in] Entry-point name, may be null
+{
+    const int stageCount = static_cast<int>(pProgram->linkGroups.size());
+    if ((stageIndex < 0) || (stageIndex >= stageCount) || (pProgram->linkGroups[stageIndex] < 0))
+    {
+        pProgram->AddLog("stage was not compiled with SpvGenOptionRetainShaders.\n");
+        return false;
+    }
+
+    if (sourceStringCount <= 0)
+    {
+        pProgram->AddLog("a stage of a link group can't be removed.\n");
+        return false;
+    }
+
+    const int options = pProgram->options;
+    const int linkGroup = pProgram->linkGroups[stageIndex];
+    EShMessages messages = EShMsgDefault;
+    SetMessageOptions(messages, options);
+
+    // The replaced stage and the retained sources of the other stages of the link group are parsed concurrently
+    std::vector<std::unique_ptr<glslang::TShader>> shaders(stageCount);
+    std::unique_ptr<bool[]> parseResults(new bool[stageCount]());
+    std::vector<SpvCompileStageStats> stageStats = pProgram->stageStats;
+    SpvTaskGroup parseGroup(SpvThreadPool::GetDefault());
+    for (int i = 0; i < stageCount; ++i)
+    {
+        if (pProgram->linkGroups[i] == linkGroup)
+        {
+            stageStats[i] = SpvCompileStageStats();
+            if (i == stageIndex)
+            {
+                shaders[i].reset(CreateShader(pProgram->stageTypes[i],
+                                              sourceStringCount,
+                                              sourceList,
+                                              fileList,
+                                              entryPoint,
+                                              pProgram->preamble.c_str(),
+                                              options));
+                for (int j = 0; j < sourceStringCount; ++j)
+                {
+                    stageStats[i].sourceSize += strlen(sourceList[j]);
+                }
+            }
+            else
+            {
+                shaders[i].reset(CreateRetainedShader(pProgram, i));
+                for (const std::string& string : pProgram->stageSources[i].strings)
+                {
+                    stageStats[i].sourceSize += string.size();
+                }
+            }
+
+            parseGroup.Run([&, i]()
+                {
+                    parseResults[i] =
+                        ParseShader(shaders[i].get(), messages, options, &pProgram->resources, &stageStats[i]);
+                });
+        }
+    }
+    parseGroup.Wait();
+
+    bool success = true;
+    for (int i = 0; i < stageCount; ++i)
+    {
+        if (shaders[i] != nullptr)
+        {
+            success = success && parseResults[i];
+            if ((options & SpvGenOptionSuppressInfolog) == false)
+            {
+                pProgram->AddCompileLog(shaders[i].get());
+            }
+        }
+    }
+
+    std::unique_ptr<glslang::TProgram> pLinkProgram;
+    success = success && (SpvMemoryTracker::IsCurrentBudgetExceeded() == false);
+    if (success)
+    {
+        pLinkProgram.reset(new glslang::TProgram);
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (shaders[i] != nullptr)
+            {
+                pLinkProgram->addShader(shaders[i].get());
+            }
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        success = pLinkProgram->link(messages);
+        const uint64_t linkTime = GetElapsedTime(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        success = success && pLinkProgram->mapIO();
+        const uint64_t mapIoTime = GetElapsedTime(startTime);
+
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (shaders[i] != nullptr)
+            {
+                stageStats[i].linkTime = linkTime;
+                stageStats[i].mapIoTime = mapIoTime;
+            }
+        }
+
+        if ((options & SpvGenOptionSuppressInfolog) == false)
+        {
+            pProgram->AddLinkLog(pLinkProgram.get());
+        }
+    }
+
+    // The SPIR-V of every stage of the link group is generated aside, SPV program is only updated once the call can't
+    // fail anymore
+    std::vector<std::vector<unsigned int>> spirvs(stageCount);
+    success = success && (SpvMemoryTracker::IsCurrentBudgetExceeded() == false);
+    if (success)
+    {
+        SpvTaskGroup spirvGroup(SpvThreadPool::GetDefault());
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (shaders[i] != nullptr)
+            {
+                const glslang::TIntermediate* pIntermediate = pLinkProgram->getIntermediate(shaders[i]->getStage());
+                std::vector<unsigned int>* pSpirv = &spirvs[i];
+                SpvCompileStageStats* pStats = &stageStats[i];
+                spirvGroup.Run([pIntermediate, options, pSpirv, pStats]()
+                    {
+                        SpvPoolAllocatorScope poolScope;
+                        GenerateSpirv(*pIntermediate, options, pSpirv, pStats);
+                    });
+            }
+        }
+        spirvGroup.Wait();
+        success = (SpvMemoryTracker::IsCurrentBudgetExceeded() == false);
+    }
+
+    if (success)
+    {
+        pProgram->stageStats.swap(stageStats);
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (shaders[i] != nullptr)
+            {
+                pProgram->spirvs[i].swap(spirvs[i]);
+            }
+        }
+
+        std::vector<std::string> strings(sourceList, sourceList + sourceStringCount);
+        std::vector<std::string> fileNames;
+        if (fileList != nullptr)
+        {
+            fileNames.assign(fileList, fileList + sourceStringCount);
+        }
+        SpvProgram::SpvStageSource& stageSource = pProgram->stageSources[stageIndex];
+        stageSource.strings.swap(strings);
+        stageSource.fileNames.swap(fileNames);
+        stageSource.hasEntryPoint = (entryPoint != nullptr);
+        stageSource.entryPoint = (entryPoint != nullptr) ? entryPoint : "";
+    }
+
+    // The program is released ahead of the shaders it linked
+    pLinkProgram.reset();
+    return success;
+}
+
+// =====================================================================================================================
+// Replace the source of one stage of a program compiled with SpvGenOptionRetainShaders. Only the link group of the
+// stage is compiled again: the new source and the retained sources of the other stages of the group are parsed
+// concurrently, linked, and translated to SPIR-V. Parsing, linking and GlslangToSpv of the other link groups of the
+// program are skipped. On failure the program keeps its previous SPIR-V binaries.
+//
+// NOTE: No glslang object outlives the call, the program only retains the sources of its stages. The memory allocated
+// by the call is accounted for spvGetLastMemoryStats, and the call fails if it exceeds the memory budget of the
+// calling thread. The log returned by earlier calls on this program is invalidated, and the program must not be used
+// by other threads during the call.
+bool SH_IMPORT_EXPORT spvRecompileProgramStage(
+    void*                hProgram,            // [in] Program compiled with SpvGenOptionRetainShaders
+    int                  stageIndex,          // Index of the stage in the stage list of the initial compile
+    int                  sourceStringCount,   // Number of source strings of the stage
+    const char* const*   sourceList,          // [in] Source strings of the stage
+    const char* const*   fileList,            // [in] File names of the source strings, may be null
+    const char*          entryPoint,          // [in] Entry-point name, may be null
+    const char**         ppLog)               // [out] Compile and link log
+{
+    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
+    pProgram->ClearLog();
+
+    SpvMemoryTracker tracker(ThreadMemoryBudget);
+    bool success = false;
+    {
+        SpvMemoryScope memoryScope(&tracker);
+        success = RecompileProgramStage(pProgram, stageIndex, sourceStringCount, sourceList, fileList, entryPoint);
+
+        if (tracker.IsBudgetExceeded())
+        {
+            char buffer[128];
+            Snprintf(buffer,
+                     sizeof(buffer),
+                     "error: memory budget of %llu bytes exceeded, the recompile was aborted\n",
+                     static_cast<unsigned long long>(tracker.GetBudget()));
+            pProgram->AddLog(buffer);
+            success = false;
+        }
+        *ppLog = pProgram->GetCompileLog(pProgram->options);
+    }
+    PublishMemoryStats(tracker);
+
+    return success;
+}
+
+// =====================================================================================================================
+// Enable the in-memory compile cache with the specified maximum number of entries, or disable and release it if
+// maxEntryCount is 0
+void SH_IMPORT_EXPORT spvSetCompileCacheSize(
+    unsigned int maxEntryCount)
+{
+    std::shared_ptr<SpvCompileCache> pCache;
+    if (maxEntryCount > 0)
+    {
+        pCache = std::make_shared<SpvCompileCache>(maxEntryCount);
+    }
+
+    // Compiles in flight keep the old cache alive until they finish
+    std::atomic_store(&DefaultContext.pCompileCache, pCache);
+}
+
+// =====================================================================================================================
+// Enable the persistent compile cache in the specified directory, or disable it if pCacheDir is null. Returns false if
+// the cache directory can't be used.
+//
+// NOTE: The directory is created if it doesn't exist. Entries written by other versions of SPVGEN or glslang are
+// discarded.
+bool SH_IMPORT_EXPORT spvSetCompileDiskCache(
+    const char* pCacheDir,
+    uint64_t    maxSize)
+{
+    std::shared_ptr<SpvDiskCache> pDiskCache;
+    bool success = true;
+    if ((pCacheDir != nullptr) && (pCacheDir[0] != '\0'))
+    {
+        pDiskCache = std::make_shared<SpvDiskCache>(pCacheDir, maxSize, GetVersionKey());
+        success = pDiskCache->Init();
+        if (success == false)
+        {
+            pDiskCache = nullptr;
+        }
+    }
+
+    std::atomic_store(&DefaultContext.pCompileDiskCache, pDiskCache);
+    return success;
+}
+
+// =====================================================================================================================
+// Create a compiler context with its own resource limits, default options and compile caches. Returns false if the
+// configuration is malformed or the persistent cache directory can't be used.
+//
+// NOTE: Limits which are absent in the configuration keep their default values. A context may be used by many threads
+// concurrently, it must not be destroyed while compiles which use it are in flight.
+bool SH_IMPORT_EXPORT spvCreateContext(
+    const SpvContextCreateInfo* pCreateInfo,   // [in] Parameters of the context
+    void**                      phContext)     // [out] Created context
+{
+    *phContext = nullptr;
+
+    std::unique_ptr<SpvContext> pContext(new SpvContext());
+    pContext->defaultOptions = pCreateInfo->defaultOptions;
+
+    ParseResourceConfig(DefaultConfig, &pContext->resources);
+    if ((pCreateInfo->pConfig != nullptr) &&
+        (ParseResourceConfig(pCreateInfo->pConfig, &pContext->resources) == false))
+    {
+        return false;
+    }
+
+    if (pCreateInfo->compileCacheSize > 0)
+    {
+        pContext->pCompileCache = std::make_shared<SpvCompileCache>(pCreateInfo->compileCacheSize);
+    }
+
+    if ((pCreateInfo->pDiskCacheDir != nullptr) && (pCreateInfo->pDiskCacheDir[0] != '\0'))
+    {
+        pContext->pCompileDiskCache =
+            std::make_shared<SpvDiskCache>(pCreateInfo->pDiskCacheDir, pCreateInfo->diskCacheSize, GetVersionKey());
+        if (pContext->pCompileDiskCache->Init() == false)
+        {
+            return false;
+        }
+    }
+
+    *phContext = pContext.release();
+    return true;
+}
+
+// =====================================================================================================================
+// Destroy a context created by spvCreateContext, programs compiled with it stay valid
+void SH_IMPORT_EXPORT spvDestroyContext(
+    void* hContext)
+{
+    delete reinterpret_cast<SpvContext*>(hContext);
+}
+
+// =====================================================================================================================
+// Get the statistics of the compile caches, returns false if both caches are disabled
+bool SH_IMPORT_EXPORT spvGetCompileCacheStats(
+    SpvCompileCacheStats* pStats)
+{
+    return spvGetCompileCacheStatsWithContext(nullptr, pStats);
+}
+
+// =====================================================================================================================
+// Get the statistics of the compile caches of the specified context, the process-wide context is used if hContext is
+// null. Returns false if both caches are disabled.
+bool SH_IMPORT_EXPORT spvGetCompileCacheStatsWithContext(
+    void*                 hContext,
+    SpvCompileCacheStats* pStats)
+{
+    const SpvContext* pContext =
+        (hContext != nullptr) ? reinterpret_cast<const SpvContext*>(hContext) : &DefaultContext;
+    std::shared_ptr<SpvCompileCache> pCache = std::atomic_load(&pContext->pCompileCache);
+    std::shared_ptr<SpvDiskCache> pDiskCache = std::atomic_load(&pContext->pCompileDiskCache);
+    if ((pCache == nullptr) && (pDiskCache == nullptr))
+    {
+        return false;
+    }
+
+    memset(pStats, 0, sizeof(SpvCompileCacheStats));
+    if (pCache != nullptr)
+    {
+        pStats->hitCount      = pCache->GetHitCount();
+        pStats->missCount     = pCache->GetMissCount();
+        pStats->evictionCount = pCache->GetEvictionCount();
+        pStats->entryCount    = pCache->GetEntryCount();
+    }
+    if (pDiskCache != nullptr)
+    {
+        pStats->diskHitCount  = pDiskCache->GetHitCount();
+        pStats->diskMissCount = pDiskCache->GetMissCount();
+    }
+    return true;
+}
+
+// =====================================================================================================================
+// Compile and link a batch of programs on the worker thread pool, returns true if all programs are compiled
+// successfully
+//
+// NOTE: pPrograms receives one program per item, each of them must be destroyed by spvDestroyProgram. pfnCallback is
+// called from a worker thread as soon as an item is finished, it must be thread safe. ppLogs, pResults and
+// pfnCallback are optional.
+bool SH_IMPORT_EXPORT spvCompileBatch(
+    int                        itemCount,
+    const SpvCompileBatchItem* pItems,
+    void**                     pPrograms,
+    const char**               ppLogs,
+    bool*                      pResults,
+    SpvCompileBatchCallback    pfnCallback,
+    void*                      pUserData)
+{
+    std::atomic<bool> allSucceeded(true);
+
+    // Every item runs with the memory budget of the calling thread
+    const uint64_t memoryBudget = ThreadMemoryBudget;
+
+    SpvTaskGroup batchGroup(SpvThreadPool::GetDefault());
+    for (int i = 0; i < itemCount; ++i)
+    {
+        batchGroup.Run([&, i]()
+            {
+                const SpvCompileBatchItem& item = pItems[i];
+                const char* pLog = nullptr;
+                const uint64_t workerMemoryBudget = ThreadMemoryBudget;
+                ThreadMemoryBudget = memoryBudget;
+                bool success = spvCompileAndLinkProgramEx(item.stageCount,
+                                                          item.stageList,
+                                                          item.sourceStringCount,
+                                                          item.sourceList,
+                                                          item.fileList,
+                                                          item.entryPoints,
+                                                          &pPrograms[i],
+                                                          &pLog,
+                                                          item.options);
+                ThreadMemoryBudget = workerMemoryBudget;
+                if (ppLogs != nullptr)
+                {
+                    ppLogs[i] = pLog;
+                }
+                if (pResults != nullptr)
+                {
+                    pResults[i] = success;
+                }
+                if (success == false)
+                {
+                    allSucceeded = false;
+                }
+                if (pfnCallback != nullptr)
+                {
+                    pfnCallback(pUserData, i, success, pPrograms[i], pLog);
+                }
+            });
+    }
+    batchGroup.Wait();
+
+    return allSucceeded;
+}
+
+// =====================================================================================================================
+// Represents an asynchronous compile started by spvCompileAndLinkProgramAsync. It owns a copy of the compile input, so
+// the caller's buffers may be released as soon as the compile is started.
+class SpvCompileTicket
+{
+public:
+    // Constructor
+    SpvCompileTicket(
+        int                     stageCount,
+        const SpvGenStage*      stageTypeList,
+        const int*              shaderStageSourceCounts,
+        const char* const *     shaderStageSources[],
+        const char* const *     fileList[],
+        const char*             entryPoints[],
+        int                     options,
+        SpvCompileAsyncCallback pfnCallback,
+        void*                   pUserData)
+        :
+        stageTypes(stageTypeList, stageTypeList + stageCount),
+        sourceCounts(shaderStageSourceCounts, shaderStageSourceCounts + stageCount),
+        sourceLists(stageCount),
+        fileLists(stageCount),
+        entryPointNames(stageCount),
+        hasFileNames(fileList != nullptr),
+        hasEntryPoints(entryPoints != nullptr),
+        options(options),
+        pfnCallback(pfnCallback),
+        pUserData(pUserData),
+        memoryBudget(ThreadMemoryBudget),
+        finished(false),
+        success(false),
+        pProgram(nullptr),
+        pLog(nullptr)
+    {
+        for (int i = 0; i < stageCount; ++i)
+        {
+            for (int j = 0; j < sourceCounts[i]; ++j)
+            {
+                sourceLists[i].push_back(shaderStageSources[i][j]);
+                if (hasFileNames && (fileList[i] != nullptr))
+                {
+                    fileLists[i].push_back(fileList[i][j]);
+                }
+            }
+            if (hasEntryPoints && (entryPoints[i] != nullptr))
+            {
+                entryPointNames[i] = entryPoints[i];
+            }
+        }
+    }
+
+    // Run the compile, called on a worker thread
+    void Compile()
+    {
+        const int stageCount = static_cast<int>(stageTypes.size());
+
+        // Rebuild the pointer arrays of spvCompileAndLinkProgramEx from the owned strings
+        std::vector<std::vector<const char*>> sourcePtrs(stageCount);
+        std::vector<std::vector<const char*>> filePtrs(stageCount);
+        std::vector<const char* const*>       sourceListPtrs(stageCount);
+        std::vector<const char* const*>       fileListPtrs(stageCount);
+        std::vector<const char*>              entryPointPtrs(stageCount);
+        for (int i = 0; i < stageCount; ++i)
+        {
+            for (const std::string& source : sourceLists[i])
+            {
+                sourcePtrs[i].push_back(source.c_str());
+            }
+            for (const std::string& fileName : fileLists[i])
+            {
+                filePtrs[i].push_back(fileName.c_str());
+            }
+            sourceListPtrs[i] = sourcePtrs[i].data();
+            fileListPtrs[i] = filePtrs[i].empty() ? nullptr : filePtrs[i].data();
+            entryPointPtrs[i] = entryPointNames[i].empty() ? nullptr : entryPointNames[i].c_str();
+        }
+
+        // The compile runs with the memory budget of the thread which started it
+        const uint64_t workerMemoryBudget = ThreadMemoryBudget;
+        ThreadMemoryBudget = memoryBudget;
+
+        void* pResultProgram = nullptr;
+        const char* pResultLog = nullptr;
+        bool result = spvCompileAndLinkProgramEx(stageCount,
+                                                 stageTypes.data(),
+                                                 sourceCounts.data(),
+                                                 sourceListPtrs.data(),
+                                                 hasFileNames ? fileListPtrs.data() : nullptr,
+                                                 hasEntryPoints ? entryPointPtrs.data() : nullptr,
+                                                 &pResultProgram,
+                                                 &pResultLog,
+                                                 options);
+        ThreadMemoryBudget = workerMemoryBudget;
+
+        // The result is published before the callback runs, so the callback may wait for or destroy the ticket. The
+        // ticket may be destroyed as soon as the lock is released, so it isn't touched afterwards.
+        const SpvCompileAsyncCallback pfnResultCallback = pfnCallback;
+        void* const pResultUserData = pUserData;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            success = result;
+            pProgram = pResultProgram;
+            pLog = pResultLog;
+            finished = true;
+            done.notify_all();
+        }
+
+        if (pfnResultCallback != nullptr)
+        {
+            pfnResultCallback(pResultUserData, result, pResultProgram, pResultLog);
+        }
+    }
+
+    // Wait for the compile to finish, returns false if it isn't finished after the timeout
+    bool Wait(
+        uint32_t timeoutMs)     // Timeout in milliseconds, UINT32_MAX waits forever
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        if (timeoutMs == UINT32_MAX)
+        {
+            done.wait(guard, [this]() { return finished; });
+            return true;
+        }
+        return done.wait_for(guard, std::chrono::milliseconds(timeoutMs), [this]() { return finished; });
+    }
+
+    // Get the compile result, only valid once the compile is finished
+    bool GetResult(
+        void**       ppProgram,
+        const char** ppLog)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        *ppProgram = pProgram;
+        *ppLog = pLog;
+        return success;
+    }
+
+private:
+    std::vector<SpvGenStage>              stageTypes;
+    std::vector<int>                      sourceCounts;
+    std::vector<std::vector<std::string>> sourceLists;
+    std::vector<std::vector<std::string>> fileLists;
+    std::vector<std::string>              entryPointNames;
+    bool                                  hasFileNames;
+    bool                                  hasEntryPoints;
+    int                                   options;
+    SpvCompileAsyncCallback               pfnCallback;
+    void*                                 pUserData;
+    uint64_t                              memoryBudget;   // Memory budget of the thread which started the compile
+
+    std::mutex                            lock;
+    std::condition_variable               done;
+    bool                                  finished;
+    bool                                  success;
+    void*                                 pProgram;     // Owned by the caller once the compile is finished
+    const char*                           pLog;
+};
+
+// =====================================================================================================================
+// Start compiling and linking GLSL source strings on the worker thread pool, and return a ticket of the compile
+// immediately. The parameters match spvCompileAndLinkProgramEx, the input is copied so it needn't outlive this call.
+//
+// NOTE: The ticket must be destroyed by spvDestroyCompileTicket, the resulting program is owned by the caller and must
+// be destroyed by spvDestroyProgram. pfnCallback is optional, it is called from a worker thread once the compile is
+// finished and its result is published: the callback may wait for or destroy its own ticket, and spvWaitCompileTicket
+// may return before the callback has run.
+void* SH_IMPORT_EXPORT spvCompileAndLinkProgramAsync(
+    int                     stageCount,
+    const SpvGenStage*      stageTypeList,
+    const int*              shaderStageSourceCounts,
+    const char* const *     shaderStageSources[],
+    const char* const *     fileList[],
+    const char*             entryPoints[],
+    int                     options,
+    SpvCompileAsyncCallback pfnCallback,
+    void*                   pUserData)
+{
+    SpvCompileTicket* pTicket = new SpvCompileTicket(stageCount,
+                                                     stageTypeList,
+                                                     shaderStageSourceCounts,
+                                                     shaderStageSources,
+                                                     fileList,
+                                                     entryPoints,
+                                                     options,
+                                                     pfnCallback,
+                                                     pUserData);
+    SpvThreadPool::GetDefault()->Submit([pTicket]() { pTicket->Compile(); });
+    return pTicket;
+}
+
+// =====================================================================================================================
+// Wait for an asynchronous compile to finish, returns true if it is finished. A timeout of 0 polls the ticket, a
+// timeout of UINT32_MAX waits forever.
+bool SH_IMPORT_EXPORT spvWaitCompileTicket(
+    void*        hTicket,
+    unsigned int timeoutMs)
+{
+    SpvCompileTicket* pTicket = reinterpret_cast<SpvCompileTicket*>(hTicket);
+    return pTicket->Wait(timeoutMs);
+}
+
+// =====================================================================================================================
+// Get the result of a finished asynchronous compile, same as the result of spvCompileAndLinkProgramEx. It waits for the
+// compile if it isn't finished yet.
+bool SH_IMPORT_EXPORT spvGetCompileTicketResult(
+    void*        hTicket,
+    void**       ppProgram,
+    const char** ppLog)
+{
+    SpvCompileTicket* pTicket = reinterpret_cast<SpvCompileTicket*>(hTicket);
+    pTicket->Wait(UINT32_MAX);
+    return pTicket->GetResult(ppProgram, ppLog);
+}
+
+// =====================================================================================================================
+// Destroy a ticket returned by spvCompileAndLinkProgramAsync, it waits for the compile if it isn't finished yet
+//
+// NOTE: The resulting program isn't destroyed.
+void SH_IMPORT_EXPORT spvDestroyCompileTicket(
+    void* hTicket)
+{
+    SpvCompileTicket* pTicket = reinterpret_cast<SpvCompileTicket*>(hTicket);
+    pTicket->Wait(UINT32_MAX);
+    delete pTicket;
+}
+
+// =====================================================================================================================
+// Represents the result of spvCompilePermutations. Permutations whose SPIR-V binaries are identical in every stage
+// share one copy of them.
+class SpvPermutationSet
+{
+public:
+    // Result of one permutation
+    struct Permutation
+    {
+        bool              success = false;
+        int               uniqueIndex = -1;   // Index of the binaries in uniqueSpirvs, -1 if the compile failed
+        SpvDiagnosticList diagnostics;        // Compile and link log
+        std::string       log;                // Formatted log, valid if logFormatted is set
+        bool              logFormatted = false;
+    };
+
+    int                                                    stageCount = 0;
+    std::vector<Permutation>                               permutations;
+    std::mutex                                             logLock;        // Protects the formatting on demand
+    std::vector<std::vector<std::vector<unsigned int> > >  uniqueSpirvs;   // Binary of each stage, per unique output
+};
+
+// =====================================================================================================================
+// Build the preamble which defines the macros of a permutation. glslang parses it ahead of the source strings, the
+// source itself is never copied.
+static std::string BuildMacroPreamble(
+    const SpvPermutation& permutation)   // [in] Macros of the permutation
+{
+    std::string preamble;
+    for (int i = 0; i < permutation.macroCount; ++i)
+    {
+        const SpvMacroDefinition& macro = permutation.pMacros[i];
+        preamble += "#define ";
+        preamble += macro.pName;
+        if (macro.pValue != nullptr)
+        {
+            preamble += ' ';
+            preamble += macro.pValue;
+        }
+        preamble += '\n';
+    }
+    return preamble;
+}
+
+// =====================================================================================================================
+// Compile one program for each of a list of macro sets on the worker thread pool, returns true if all permutations are
+// compiled successfully. The process-wide context is used if hContext is null.
+//
+// NOTE: The macros are defined by a preamble, so the compile cache keeps the permutations apart without the sources
+// being copied. Permutations which produce bit-identical SPIR-V in every stage share the same binaries, see
+// spvGetPermutationResult. Every permutation runs with the memory budget of the calling thread.
+bool SH_IMPORT_EXPORT spvCompilePermutations(
+    void*                      hContext,           // [in] Compiler context, may be null
+    const SpvCompileBatchItem* pProgram,           // [in] Program compiled for every permutation
+    int                        permutationCount,   // Number of permutations
+    const SpvPermutation*      pPermutations,      // [in] Macros of each permutation
+    void**                     phPermutations)     // [out] Result, must be destroyed by spvDestroyPermutations
+{
+    SpvContext* pContext = (hContext != nullptr) ? reinterpret_cast<SpvContext*>(hContext) : &DefaultContext;
+    const uint64_t memoryBudget = ThreadMemoryBudget;
+
+    SpvPermutationSet* pSet = new SpvPermutationSet;
+    pSet->stageCount = pProgram->stageCount;
+    pSet->permutations.resize(permutationCount);
+    *phPermutations = pSet;
+
+    // Binaries of each permutation until they are deduplicated, with their hashes
+    std::vector<std::vector<std::vector<unsigned int> > > spirvs(permutationCount);
+    std::vector<SpvHash128> hashes(permutationCount);
+
+    SpvTaskGroup permutationGroup(SpvThreadPool::GetDefault());
+    for (int i = 0; i < permutationCount; ++i)
+    {
+        permutationGroup.Run([&, i]()
+            {
+                const std::string preamble = BuildMacroPreamble(pPermutations[i]);
+                void* hProgram = nullptr;
+                const char* pLog = nullptr;
+                const uint64_t workerMemoryBudget = ThreadMemoryBudget;
+                ThreadMemoryBudget = memoryBudget;
+                bool success = CompileAndLinkProgramTracked(pContext,
+                                                            pProgram->stageCount,
+                                                            pProgram->stageList,
+                                                            pProgram->sourceStringCount,
+                                                            pProgram->sourceList,
+                                                            pProgram->fileList,
+                                                            pProgram->entryPoints,
+                                                            preamble.c_str(),
+                                                            &hProgram,
+                                                            &pLog,
+                                                            pProgram->options | SpvGenOptionDeferLog);
+                ThreadMemoryBudget = workerMemoryBudget;
+
+                SpvProgram* pCompiled = reinterpret_cast<SpvProgram*>(hProgram);
+                SpvPermutationSet::Permutation& permutation = pSet->permutations[i];
+                permutation.success = success && (pCompiled != nullptr);
+                if (pCompiled != nullptr)
+                {
+                    permutation.diagnostics = std::move(pCompiled->diagnostics);
+                    if (permutation.success)
+                    {
+                        SpvHasher hasher;
+                        for (const auto& spirv : pCompiled->spirvs)
+                        {
+                            hasher.Update(spirv.size());
+                            hasher.Update(spirv.data(), spirv.size() * sizeof(unsigned int));
+                        }
+                        hashes[i] = hasher.Finalize();
+                        spirvs[i] = std::move(pCompiled->spirvs);
+                    }
+                    delete pCompiled;
+                }
+            });
+    }
+    permutationGroup.Wait();
+
+    // Deduplicate in permutation order, so that the unique outputs don't depend on the order the compiles finished in.
+    // The binaries are compared in full, the hash only narrows down the candidates.
+    bool allSucceeded = true;
+    std::unordered_multimap<SpvHash128, int, SpvHash128Hasher> uniqueIndices;
+    for (int i = 0; i < permutationCount; ++i)
+    {
+        SpvPermutationSet::Permutation& permutation = pSet->permutations[i];
+        if (permutation.success == false)
+        {
+            allSucceeded = false;
+            continue;
+        }
+
+        auto candidates = uniqueIndices.equal_range(hashes[i]);
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            if (pSet->uniqueSpirvs[it->second] == spirvs[i])
+            {
+                permutation.uniqueIndex = it->second;
+                break;
+            }
+        }
+
+        if (permutation.uniqueIndex < 0)
+        {
+            permutation.uniqueIndex = static_cast<int>(pSet->uniqueSpirvs.size());
+            uniqueIndices.insert({ hashes[i], permutation.uniqueIndex });
+            pSet->uniqueSpirvs.push_back(std::move(spirvs[i]));
+        }
+        spirvs[i].clear();
+    }
+
+    return allSucceeded;
+}
+
+// =====================================================================================================================
+// Get the result of one permutation compiled by spvCompilePermutations, returns true if it is compiled successfully
+//
+// NOTE: Permutations with the same unique index have bit-identical SPIR-V binaries in every stage, the unique index is
+// -1 if the compile failed. The log is formatted on first use and stays valid until the permutation set is destroyed.
+bool SH_IMPORT_EXPORT spvGetPermutationResult(
+    void*        hPermutations,
+    int          permutation,
+    int*         pUniqueIndex,   // [out] Index of the shared binaries, may be null
+    const char** ppLog)          // [out] Compile and link log, may be null
+{
+    SpvPermutationSet* pSet = reinterpret_cast<SpvPermutationSet*>(hPermutations);
+    SpvPermutationSet::Permutation& result = pSet->permutations[permutation];
+    if (pUniqueIndex != nullptr)
+    {
+        *pUniqueIndex = result.uniqueIndex;
+    }
+    if (ppLog != nullptr)
+    {
+        std::lock_guard<std::mutex> guard(pSet->logLock);
+        if (result.logFormatted == false)
+        {
+            result.diagnostics.Format(&result.log);
+            result.logFormatted = true;
+        }
+        *ppLog = result.log.c_str();
+    }
+    return result.success;
+}
+
+// =====================================================================================================================
+// Get the number of distinct outputs of the permutations compiled by spvCompilePermutations, failed permutations
+// excluded
+int SH_IMPORT_EXPORT spvGetPermutationUniqueCount(
+    void* hPermutations)
+{
+    const SpvPermutationSet* pSet = reinterpret_cast<const SpvPermutationSet*>(hPermutations);
+    return static_cast<int>(pSet->uniqueSpirvs.size());
+}
+
+// =====================================================================================================================
+// Get the SPIR-V binary of one stage of a permutation, and return the binary size in bytes. Permutations with the same
+// unique index return the same pointer, the binary stays valid until the permutation set is destroyed.
+//
+// NOTE: 0 is returned if the permutation failed to compile or the stage has no SPIR-V binary.
+int SH_IMPORT_EXPORT spvGetPermutationSpirv(
+    void*                hPermutations,
+    int                  permutation,
+    int                  stage,
+    const unsigned int** ppData)   // [out] SPIR-V binary
+{
+    const SpvPermutationSet* pSet = reinterpret_cast<const SpvPermutationSet*>(hPermutations);
+    const int uniqueIndex = pSet->permutations[permutation].uniqueIndex;
+    *ppData = nullptr;
+    if (uniqueIndex < 0)
+    {
+        return 0;
+    }
+
+    const std::vector<unsigned int>& spirv = pSet->uniqueSpirvs[uniqueIndex][stage];
+    if (spirv.empty() == false)
+    {
+        *ppData = spirv.data();
+    }
+    return static_cast<int>(spirv.size() * sizeof(unsigned int));
+}
+
+// =====================================================================================================================
+// Release the result of spvCompilePermutations
+void SH_IMPORT_EXPORT spvDestroyPermutations(
+    void* hPermutations)
+{
+    delete reinterpret_cast<SpvPermutationSet*>(hPermutations);
+}
+
+// =====================================================================================================================
+// Set the number of worker threads used by the parallel and asynchronous entry-points, 0 means one thread per hardware
+// thread. Returns false if the worker threads are already running, it must be called before the first compile.
+bool SH_IMPORT_EXPORT spvSetThreadCount(
+    unsigned int threadCount)
+{
+    return SpvThreadPool::SetDefaultThreadCount(threadCount);
+}
+
+// =====================================================================================================================
+// Parse a trivial shader, so that glslang builds and caches the built-in symbol tables of its stage, version and profile
+void WarmupShader(
+    SpvGenStage stageType,  // Shader stage
+    int         version,    // GLSL version, ignored for HLSL
+    int         options)    // Compile options
+{
+    char source[64];
+    if (options & SpvGenOptionReadHlsl)
+    {
+        Snprintf(source, sizeof(source), "void main() {}\n");
+    }
+    else
+    {
+        const bool isEs = (version == 100) || (version == 300) || (version == 310) || (version == 320);
+        Snprintf(source, sizeof(source), "#version %d%s\nvoid main() {}\n", version, isEs ? " es" : "");
+    }
+
+    const char* pSource = source;
+    EShMessages messages = EShMsgDefault;
+    SetMessageOptions(messages, options);
+
+    // The result doesn't matter, the symbol tables are set up before the shader body is parsed
+    glslang::TShader* pShader = CreateShader(stageType, 1, &pSource, nullptr, "main", nullptr, options);
+    ParseShader(pShader, messages, options, &DefaultContext.resources, nullptr);
+    delete pShader;
+}
+
+// =====================================================================================================================
+// Pre-build the glslang built-in symbol tables of every combination of the specified stages and GLSL versions, so that
+// the first real compile of each combination doesn't pay for them. The options select the source language and client
+// API the same way as for spvCompileAndLinkProgramEx.
+//
+// NOTE: If waitIdle is false, the tables are built on the worker thread pool in the background and this returns
+// immediately.
+void SH_IMPORT_EXPORT spvWarmup(
+    int                stageCount,
+    const SpvGenStage* stageList,
+    int                versionCount,
+    const int*         versions,
+    int                options,
+    bool               waitIdle)
+{
+    SpvThreadPool* pPool = SpvThreadPool::GetDefault();
+    if (waitIdle)
+    {
+        SpvTaskGroup warmupGroup(pPool);
+        for (int i = 0; i < stageCount; ++i)
+        {
+            for (int j = 0; j < versionCount; ++j)
+            {
+                SpvGenStage stage = stageList[i];
+                int version = versions[j];
+                warmupGroup.Run([stage, version, options]() { WarmupShader(stage, version, options); });
+            }
+        }
+        warmupGroup.Wait();
+    }
+    else
+    {
+        for (int i = 0; i < stageCount; ++i)
+        {
+            for (int j = 0; j < versionCount; ++j)
+            {
+                SpvGenStage stage = stageList[i];
+                int version = versions[j];
+                pPool->Submit([stage, version, options]() { WarmupShader(stage, version, options); });
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Destroies SpvProgram object
+void SH_IMPORT_EXPORT spvDestroyProgram(
+    void* hProgram)
+{
+    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
+    delete pProgram;
+}
+
+// =====================================================================================================================
+// Get SPRIV binary from OGLProgram object with specified shader stage, and return the binary size in bytes
+//
+// NOTE: 0 is returned if SPIRVI binary isn't exist for specified shader stage
+int SH_IMPORT_EXPORT spvGetSpirvBinaryFromProgram(
+    void*                hProgram,
+    int                  stage,
+    const unsigned int** ppData)
+{
+    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
+    int programSize = (int)(pProgram->spirvs[stage].size() * sizeof(unsigned int));
+    if (programSize > 0)
+    {
+        *ppData = &pProgram->spirvs[stage][0];
+    }
+    else
+    {
+        *ppData = nullptr;
+    }
+    return programSize;
+}
+
+// =====================================================================================================================
+// Take the SPIR-V binary of the specified shader stage out of the program without copying it, and return the binary
+// size in bytes. The binary stays valid after the program is destroyed, it must be released by spvDestroySpirvBinary.
+//
+// NOTE: 0 is returned if SPIR-V binary isn't exist for specified shader stage, later calls for the same stage return 0.
+int SH_IMPORT_EXPORT spvDetachSpirvBinaryFromProgram(
+    void*                hProgram,
+    int                  stage,
+    void**               phBinary,   // [out] Handle of the detached binary
+    const unsigned int** ppData)     // [out] Detached binary
+{
+    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
+    int programSize = (int)(pProgram->spirvs[stage].size() * sizeof(unsigned int));
+    if (programSize > 0)
+    {
+        auto pBinary = new std::vector<unsigned int>(std::move(pProgram->spirvs[stage]));
+        pProgram->spirvs[stage].clear();
+        *phBinary = pBinary;
+        *ppData = pBinary->data();
+    }
+    else
+    {
+        *phBinary = nullptr;
+        *ppData = nullptr;
+    }
+    return programSize;
+}
+
+// =====================================================================================================================
+// Release a SPIR-V binary returned by spvDetachSpirvBinaryFromProgram
+void SH_IMPORT_EXPORT spvDestroySpirvBinary(
+    void* hBinary)
+{
+    delete reinterpret_cast<std::vector<unsigned int>*>(hBinary);
+}
+
+// =====================================================================================================================
+// Get the per-phase timing and size statistics of the specified shader stage, returns false if the stage index is out
+// of range
+//
+// NOTE: Link and IO mapping times are measured per link group, they are reported for every stage of the group.
+bool SH_IMPORT_EXPORT spvGetProgramStats(
+    void*                 hProgram,
+    int                   stage,
+    SpvCompileStageStats* pStats)   // [out] Statistics of the stage
+{
+    const SpvProgram* pProgram = reinterpret_cast<const SpvProgram*>(hProgram);
+    if ((stage < 0) || (static_cast<size_t>(stage) >= pProgram->stageStats.size()))
+    {
+        return false;
+    }
+
+    *pStats = pProgram->stageStats[stage];
+    return true;
+}
+
+// =====================================================================================================================
+// Get the compile and link log of a program. It is formatted from the diagnostics on first use, so it costs nothing for
+// programs compiled with SpvGenOptionDeferLog whose log is never queried.
+//
+// NOTE: The log stays valid until the program is destroyed or one of its stages is recompiled.
+const char* SH_IMPORT_EXPORT spvGetProgramLog(
+    void* hProgram)   // [in] Program
+{
+    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
+    return pProgram->GetLog();
+}
+
+// =====================================================================================================================
+// Get the diagnostics of the compile and link log of a program, returns the number of diagnostics. They are parsed from
+// the glslang info logs when the logs are captured.
+//
+// NOTE: The diagnostics stay valid until the program is destroyed or one of its stages is recompiled.
+unsigned int SH_IMPORT_EXPORT spvGetProgramDiagnostics(
+    void*                 hProgram,        // [in] Program
+    const SpvDiagnostic** ppDiagnostics)   // [out] Array of the diagnostics, null if there are none
+{
+    SpvProgram* pProgram = reinterpret_cast<SpvProgram*>(hProgram);
+    const SpvDiagnosticList& diagnostics = pProgram->GetDiagnostics();
+    *ppDiagnostics = diagnostics.GetData();
+    return diagnostics.GetCount();
+}
+
+// =====================================================================================================================
+// Deduce the language from the filename.  Files must end in one of the following extensions:
+SpvGenStage SH_IMPORT_EXPORT spvGetStageTypeFromName(
+    const char* pName,
+    bool*       pIsHlsl)
+{
+    std::string name = pName;
+    size_t ext = name.rfind('.');
+    if (ext == std::string::npos)
+    {
+        return SpvGenStageInvalid;
+    }
+
+    std::string suffix = name.substr(ext + 1, std::string::npos);
+    if (suffix == "glsl" || suffix == "hlsl")
+    {
+        if (suffix == "hlsl")
+        {
+            *pIsHlsl = true;
+        }
+
+        // for .vert.glsl, .tesc.glsl, ..., .comp.glsl/.hlsl compound suffixes
+        name = name.substr(0, ext);
+        ext = name.rfind('.');
+        if (ext == std::string::npos) {
+            return SpvGenStageInvalid;
+        }
+        suffix = name.substr(ext + 1, std::string::npos);
+    }
+
+    if (suffix == "task")
+        return SpvGenStageTask;
+    else if (suffix == "vert")
+        return SpvGenStageVertex;
+    else if (suffix == "tesc")
+        return SpvGenStageTessControl;
+    else if (suffix == "tese")
+        return SpvGenStageTessEvaluation;
+    else if (suffix == "geom")
+        return SpvGenStageGeometry;
+    else if (suffix == "mesh")
+        return SpvGenStageMesh;
+    else if (suffix == "frag")
+        return SpvGenStageFragment;
+    else if (suffix == "comp")
+        return SpvGenStageCompute;
+    else if (suffix == "rgen")
+        return SpvGenStageRayTracingRayGen;
+    else if (suffix == "rint")
+        return SpvGenStageRayTracingIntersect;
+    else if (suffix == "rahit")
+        return SpvGenStageRayTracingAnyHit;
+    else if (suffix == "rchit")
+        return SpvGenStageRayTracingClosestHit;
+    else if (suffix == "rmiss")
+        return SpvGenStageRayTracingMiss;
+    else if (suffix == "rcall")
+        return SpvGenStageRayTracingCallable;
+
+    return SpvGenStageInvalid;
+}
+
+// =====================================================================================================================
+// Gets component version according to specified SpvGenVersion enum
+bool SH_IMPORT_EXPORT spvGetVersion(
+    SpvGenVersion version,
+    unsigned int* pVersion,
+    unsigned int* pReversion)
+{
+    bool result = true;
+    switch (version)
+    {
+    case SpvGenVersionGlslang:
+        {
+            *pVersion = glslang::GetSpirvGeneratorVersion();
+            *pReversion = GLSLANG_VERSION_MINOR;
+            break;
+        }
+    case SpvGenVersionSpirv:
+        {
+            *pVersion = spv::Version;
+            *pReversion = spv::Revision;
+            break;
+        }
+    case SpvGenVersionStd450:
+        {
+            *pVersion = spv::GLSLstd450Version;
+            *pReversion = spv::GLSLstd450Revision;
+            break;
+        }
+    case SpvGenVersionExtAmd:
+        {
+            *pVersion = spv::GLSLextAMDVersion;
+            *pReversion = spv::GLSLextAMDRevision;
+            break;
+        }
+    case SpvGenVersionSpvGen:
+        {
+            *pVersion = SPVGEN_VERSION;
+            *pReversion = SPVGEN_REVISION;
+            break;
+        }
+    default:
+        {
+            result = false;
+            break;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Get the allocator for the output buffers of a call, the global allocator is used if pAllocator is null
+static SpvAllocationCallbacks GetAllocator(
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator of the call, may be null
+{
+    if (pAllocator != nullptr)
+    {
+        return *pAllocator;
+    }
+
+    std::lock_guard<std::mutex> guard(AllocatorLock);
+    return GlobalAllocator;
+}
+
+// =====================================================================================================================
+// Allocate an output buffer with the specified allocator, falls back to malloc if the allocator has no callbacks.
+//
+// NOTE: The buffer is accounted to the memory tracker of the call. It is the last step of the call, so it is also the
+// last point where the memory budget is checked: null is returned if the buffer would exceed it.
+static void* AllocateBuffer(
+    const SpvAllocationCallbacks& allocator,
+    size_t                        size)
+{
+    SpvMemoryTracker* pTracker = SpvMemoryTracker::GetCurrent();
+    if (pTracker != nullptr)
+    {
+        pTracker->OnAllocate(size);
+        if (pTracker->IsBudgetExceeded())
+        {
+            pTracker->OnFree(size);
+            return nullptr;
+        }
+    }
+
+    if (allocator.pfnAllocation != nullptr)
+    {
+        return allocator.pfnAllocation(allocator.pUserData, size, alignof(std::max_align_t));
+    }
+    return malloc(size);
+}
+
+// =====================================================================================================================
+// Assemble SPIR-V text of the specified length with the shared SPIRV-Tools context of its version. The text is read in
+// place, it doesn't have to be null terminated.
+static spv_result_t AssembleSpirv(
+    const char*     pSpvText,
+    size_t          textLength,
+    spv_binary*     pBinary,       // [out] Binary, must be released by spvBinaryDestroy
+    spv_diagnostic* pDiagnostic)   // [out] Diagnostic of a failure
+{
+    uint32_t options = SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS;
+    spv_context context = GetSpirvToolsContext(GetSpirvTargetEnv(pSpvText, textLength));
+    return spvTextToBinaryWithOptions(context, pSpvText, textLength, options, pBinary, pDiagnostic);
+}
+
+// =====================================================================================================================
+// Assemble SPIR-V text, store the result in pBuffer and return SPIRV code size in byte
+//
+// NOTE: If assemble success, *ppLog is nullptr, otherwise, *ppLog is the error message and -1 is returned. The result
+// is truncated if it exceeds bufSize, spvAssembleSpirvWithAllocator returns a buffer of the exact size.
+int SH_IMPORT_EXPORT spvAssembleSpirv(
+    const char*    pSpvText,
+    unsigned int   bufSize,
+    unsigned int*  pBuffer,
+    const char**   ppLog)
+{
+    int retval = -1;
+
+    spv_binary binary;
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result = AssembleSpirv(pSpvText, strlen(pSpvText), &binary, &diagnostic);
+    if (result == SPV_SUCCESS)
+    {
+        unsigned int codeSize = static_cast<unsigned int>(binary->wordCount * sizeof(uint32_t));
+        if (codeSize > bufSize)
+        {
+            codeSize = bufSize;
+        }
+        memcpy(pBuffer, binary->code, codeSize);
+        *ppLog = nullptr;
+        retval = codeSize;
+        spvBinaryDestroy(binary);
+    }
+    else
+    {
+        *ppLog = reinterpret_cast<const char*>(pBuffer);
+        spvDiagnosticPrint(diagnostic, reinterpret_cast<char*>(pBuffer), static_cast<size_t>(bufSize));
+        spvDiagnosticDestroy(diagnostic);
+        retval = -1;
+    }
+
+    return retval;
+}
+
+// =====================================================================================================================
+// Assemble SPIR-V text of the specified length, and store the result in a buffer of the exact size allocated with
+// pAllocator (the global allocator if it is null)
+static bool AssembleSpirvToBuffer(
+    const char*                   pSpvText,
+    size_t                        textLength,
+    unsigned int*                 pBufSize,
+    void**                        ppBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator)
+{
+    spv_binary binary = nullptr;
+    spv_diagnostic diagnostic = nullptr;
+    bool success = (AssembleSpirv(pSpvText, textLength, &binary, &diagnostic) == SPV_SUCCESS);
+    *pBufSize = 0;
+    *ppBuf = nullptr;
+    if (logSize > 0)
+    {
+        pLog[0] = '\0';
+    }
+
+    if (success)
+    {
+        const unsigned int codeSize = static_cast<unsigned int>(binary->wordCount * sizeof(uint32_t));
+        *ppBuf = AllocateBuffer(GetAllocator(pAllocator), codeSize);
+        if (*ppBuf != nullptr)
+        {
+            memcpy(*ppBuf, binary->code, codeSize);
+            *pBufSize = codeSize;
+        }
+        else
+        {
+            if (logSize > 0)
+            {
+                Snprintf(pLog, logSize, "error: failed to allocate the output buffer\n");
+            }
+            success = false;
+        }
+        spvBinaryDestroy(binary);
+    }
+    else
+    {
+        if (logSize > 0)
+        {
+            spvDiagnosticPrint(diagnostic, pLog, logSize);
+        }
+        spvDiagnosticDestroy(diagnostic);
     }
 
-    if (suffix == "task")
-        return SpvGenStageTask;
-    else if (suffix == "vert")
-        return SpvGenStageVertex;
-    else if (suffix == "tesc")
-        return SpvGenStageTessControl;
-    else if (suffix == "tese")
-        return SpvGenStageTessEvaluation;
-    else if (suffix == "geom")
-        return SpvGenStageGeometry;
-    else if (suffix == "mesh")
-        return SpvGenStageMesh;
-    else if (suffix == "frag")
-        return SpvGenStageFragment;
-    else if (suffix == "comp")
-        return SpvGenStageCompute;
-    else if (suffix == "rgen")
-        return SpvGenStageRayTracingRayGen;
-    else if (suffix == "rint")
-        return SpvGenStageRayTracingIntersect;
-    else if (suffix == "rahit")
-        return SpvGenStageRayTracingAnyHit;
-    else if (suffix == "rchit")
-        return SpvGenStageRayTracingClosestHit;
-    else if (suffix == "rmiss")
-        return SpvGenStageRayTracingMiss;
-    else if (suffix == "rcall")
-        return SpvGenStageRayTracingCallable;
+    return success;
+}
 
-    return SpvGenStageInvalid;
+// =====================================================================================================================
+// Assemble SPIR-V text of the specified length, e.g. a memory-mapped file, and store the result in *ppBuf
+//
+// NOTE: The text is read in place, it doesn't have to be null terminated. *ppBuf is allocated with the exact size of
+// the binary, which is returned in *pBufSize. It should be freed by spvFreeBuffer, or by the pfnFree callback of
+// pAllocator if it isn't null. The log will be clampped if the log size is less than requirement.
+bool SH_IMPORT_EXPORT spvAssembleSpirvWithAllocator(
+    const char*                   pSpvText,
+    size_t                        textLength,
+    unsigned int*                 pBufSize,     // [out] Size of the binary in bytes
+    void**                        ppBuf,        // [out] Binary
+    unsigned int                  logSize,
+    char*                         pLog,         // [out] Diagnostic of a failure, may be null if logSize is 0
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator of the binary, may be null
+{
+    return AssembleSpirvToBuffer(pSpvText, textLength, pBufSize, ppBuf, logSize, pLog, pAllocator);
 }
 
 // =====================================================================================================================
-// Gets component version according to specified SpvGenVersion enum
-bool SH_IMPORT_EXPORT spvGetVersion(
-    SpvGenVersion version,
-    unsigned int* pVersion,
-    unsigned int* pReversion)
+// Assemble a SPIR-V text file, and store the result in *ppBuf. The file is memory-mapped and assembled in place,
+// nothing of the text is copied.
+//
+// NOTE: *ppBuf is allocated with the exact size of the binary, see spvAssembleSpirvWithAllocator.
+bool SH_IMPORT_EXPORT spvAssembleSpirvFromFile(
+    const char*                   pFileName,
+    unsigned int*                 pBufSize,     // [out] Size of the binary in bytes
+    void**                        ppBuf,        // [out] Binary
+    unsigned int                  logSize,
+    char*                         pLog,         // [out] Diagnostic of a failure, may be null if logSize is 0
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator of the binary, may be null
 {
-    bool result = true;
-    switch (version)
+    SpvMappedFile file;
+    if (file.Open(pFileName, false) == false)
     {
-    case SpvGenVersionGlslang:
+        *pBufSize = 0;
+        *ppBuf = nullptr;
+        if (logSize > 0)
         {
-            *pVersion = glslang::GetSpirvGeneratorVersion();
-            *pReversion = GLSLANG_VERSION_MINOR;
-            break;
+            Snprintf(pLog, logSize, "error: failed to open %s\n", pFileName);
         }
-    case SpvGenVersionSpirv:
+        return false;
+    }
+
+    return AssembleSpirvToBuffer(static_cast<const char*>(file.GetData()),
+                                 file.GetSize(),
+                                 pBufSize,
+                                 ppBuf,
+                                 logSize,
+                                 pLog,
+                                 pAllocator);
+}
+
+// =====================================================================================================================
+// Disassemble SPIR-V binary token with the options of spvDisassembleSpirv, the text is passed to the output piece by
+// piece
+static spv_result_t DisassembleSpirv(
+    unsigned int         size,
+    const void*          pSpvToken,
+    const SpvTextOutput& output,        // [in] Receives the text, in order
+    spv_diagnostic*      pDiagnostic)   // [out] Diagnostic of an invalid binary
+{
+    const uint32_t* pCode = static_cast<const uint32_t*>(pSpvToken);
+    uint32_t options = SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
+    return DisassembleSpirvStream(GetSpirvToolsContext(GetSpirvTargetEnv(pCode)),
+                                  pCode,
+                                  static_cast<size_t>(size) / sizeof(uint32_t),
+                                  options,
+                                  output,
+                                  pDiagnostic);
+}
+
+// =====================================================================================================================
+// Disassemble SPIR-V binary token using khronos spirv-tools, and store the output text to pBuffer
+//
+// NOTE: The text will be clampped if buffer size is less than requirement, spvGetSpirvDisassemblySize returns the
+// required size.
+bool SH_IMPORT_EXPORT spvDisassembleSpirv(
+    unsigned int   size,
+    const void*    pSpvToken,
+    unsigned int   bufSize,
+    char*          pBuffer)
+{
+    // The text is copied to the buffer piece by piece, so the text of the whole module is never held in memory twice
+    size_t textSize = 0;
+    const size_t maxTextSize = (bufSize > 0) ? bufSize - 1 : 0;
+    auto output = [&](const char* pText, size_t length)
         {
-            *pVersion = spv::Version;
-            *pReversion = spv::Revision;
-            break;
+            const size_t copySize = std::min(length, maxTextSize - textSize);
+            memcpy(pBuffer + textSize, pText, copySize);
+            textSize += copySize;
+
+            // Stop once the buffer is full
+            return textSize < maxTextSize;
+        };
+
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result = DisassembleSpirv(size, pSpvToken, output, &diagnostic);
+    bool success = (result == SPV_SUCCESS) || (result == SPV_REQUESTED_TERMINATION);
+    if (success)
+    {
+        if (bufSize > 0)
+        {
+            pBuffer[textSize] = '\0';
         }
-    case SpvGenVersionStd450:
+    }
+    else
+    {
+        spvDiagnosticPrint(diagnostic, pBuffer, bufSize);
+        spvDiagnosticDestroy(diagnostic);
+    }
+
+    return success;
+}
+
+// =====================================================================================================================
+// Disassemble SPIR-V binary token using khronos spirv-tools, and pass the text to pfnOutput piece by piece as it is
+// produced. Only a small part of the text is held in memory at any time, so the text of large modules can go straight
+// to a file or a socket. Returns false if the binary is invalid, with the diagnostic in pLog, or if pfnOutput stopped
+// the disassembly.
+//
+// NOTE: The concatenated pieces are the text of spvDisassembleSpirv. The diagnostic will be clampped if the log size
+// is less than requirement.
+bool SH_IMPORT_EXPORT spvDisassembleSpirvStream(
+    unsigned int          size,
+    const void*           pSpvToken,
+    SpvTextOutputCallback pfnOutput,   // [in] Receives the text, in order
+    void*                 pUserData,   // [in] Passed to pfnOutput
+    unsigned int          logSize,
+    char*                 pLog)        // [out] Diagnostic of an invalid binary, may be null if logSize is 0
+{
+    auto output = [pfnOutput, pUserData](const char* pText, size_t length)
         {
-            *pVersion = spv::GLSLstd450Version;
-            *pReversion = spv::GLSLstd450Revision;
-            break;
+            return pfnOutput(pUserData, pText, static_cast<unsigned int>(length));
+        };
+
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result = DisassembleSpirv(size, pSpvToken, output, &diagnostic);
+    if (logSize > 0)
+    {
+        pLog[0] = '\0';
+    }
+    if (diagnostic != nullptr)
+    {
+        if (logSize > 0)
+        {
+            spvDiagnosticPrint(diagnostic, pLog, logSize);
         }
-    case SpvGenVersionExtAmd:
+        spvDiagnosticDestroy(diagnostic);
+    }
+
+    return (result == SPV_SUCCESS);
+}
+
+// =====================================================================================================================
+// Get the size in bytes of the buffer spvDisassembleSpirv needs for the text of SPIR-V binary token, the terminating
+// null included. The text is measured piece by piece and never held in memory as a whole. Returns 0 if the binary is
+// invalid.
+//
+// NOTE: The query runs the whole streamed disassembly, it isn't cheaper than spvDisassembleSpirvStream.
+unsigned int SH_IMPORT_EXPORT spvGetSpirvDisassemblySize(
+    unsigned int size,
+    const void*  pSpvToken)
+{
+    size_t textSize = 0;
+    auto output = [&textSize](const char* pText, size_t length)
         {
-            *pVersion = spv::GLSLextAMDVersion;
-            *pReversion = spv::GLSLextAMDRevision;
-            break;
+            textSize += length;
+            return true;
+        };
+
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result = DisassembleSpirv(size, pSpvToken, output, &diagnostic);
+    spvDiagnosticDestroy(diagnostic);
+
+    return (result == SPV_SUCCESS) ? static_cast<unsigned int>(textSize + 1) : 0;
+}
+
+// =====================================================================================================================
+// convert SPIR-V binary token to GLSL using Khronos SPIRV-Cross,
+//
+// NOTE: ppGlslSource should be freed by spvFreeBuffer
+bool SH_IMPORT_EXPORT spvCrossSpirv(
+    SpvSourceLanguage   sourceLanguage,
+    unsigned int        size,
+    const void*         pSpvToken,
+    char**              ppSourceString)
+{
+    return spvCrossSpirvEx(sourceLanguage, 0, size, pSpvToken, ppSourceString);
+}
+
+// =====================================================================================================================
+// convert SPIR-V binary token to other shader languages using Khronos SPIRV-Cross,
+//
+// NOTE: ppGlslSource should be freed by spvFreeBuffer
+// You need to calculate the version number of sourceLanguage; if version is set to 0, will use the default version (GLSL 450).
+// For HLSL, the default version is 30 (shader model 3); version = major * 10 + minor;
+// For MSL, the default version is 1.2; use make_msl_version to calculate the version number: version = (major * 10000) + (minor * 100) + patch;
+bool SH_IMPORT_EXPORT spvCrossSpirvEx(
+    SpvSourceLanguage   sourceLanguage,
+    uint32_t            version,
+    unsigned int        size,
+    const void*         pSpvToken,
+    char**              ppSourceString)
+{
+    return spvCrossSpirvWithAllocator(sourceLanguage, version, size, pSpvToken, ppSourceString, nullptr);
+}
+
+// =====================================================================================================================
+// Convert SPIR-V binary token, or a copy of a module parsed by spvCrossParseSpirv, to other shader languages using
+// Khronos SPIRV-Cross, the output string is allocated with the specified allocator.
+//
+// NOTE: Every call converts with SPIRV-Cross objects of its own, so calls may run concurrently. A failure is only
+// reported in the log.
+static bool CrossSpirv(
+    SpvSourceLanguage             sourceLanguage,
+    uint32_t                      version,
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    const spirv_cross::ParsedIR*  pParsedIr,        // [in] Parsed module, the binary is parsed if it is null
+    char**                        ppSourceString,
+    unsigned int                  logSize,
+    char*                         pLog,             // [out] Error of a failure, may be null if logSize is 0
+    const SpvAllocationCallbacks* pAllocator)
+{
+    bool success = true;
+    std::string sourceString = "";
+    if (logSize > 0)
+    {
+        pLog[0] = '\0';
+    }
+    // The memory budget of the call is checked before and after the conversion, SPIRV-Cross runs to its end
+    if (SpvMemoryTracker::IsCurrentBudgetExceeded() == false)
+    {
+        try
+        {
+            // The compiler modifies the IR, so a parsed module is only read to copy it
+            spirv_cross::ParsedIR parsedIr;
+            if (pParsedIr != nullptr)
+            {
+                parsedIr = *pParsedIr;
+            }
+            else
+            {
+                // The parser keeps a copy of the words in the IR, so the binary is copied once either way
+                spirv_cross::Parser spvParser(static_cast<const uint32_t*>(pSpvToken), size / sizeof(uint32_t));
+                spvParser.parse();
+                parsedIr = std::move(spvParser.get_parsed_ir());
+            }
+
+            bool combineImageSamplers = false;
+            bool buildDummySampler = false;
+            std::unique_ptr<spirv_cross::CompilerGLSL> pCompiler;
+            if (sourceLanguage == SpvSourceLanguageMSL)
+            {
+                pCompiler.reset(new spirv_cross::CompilerMSL(std::move(parsedIr)));
+                auto* pMslCompiler = static_cast<spirv_cross::CompilerMSL*>(pCompiler.get());
+                auto mslOptions = pMslCompiler->get_msl_options();
+                if (version != 0)
+                {
+                    mslOptions.msl_version = version;
+                }
+                mslOptions.capture_output_to_buffer = false;
+                mslOptions.swizzle_texture_samples = false;
+                mslOptions.invariant_float_math = false;
+                mslOptions.pad_fragment_output_components = false;
+                mslOptions.tess_domain_origin_lower_left = false;
+                mslOptions.argument_buffers = false;
+                mslOptions.argument_buffers = false;
+                mslOptions.texture_buffer_native = false;
+                mslOptions.multiview = false;
+                mslOptions.view_index_from_device_index = false;
+                mslOptions.dispatch_base = false;
+                mslOptions.enable_decoration_binding = false;
+                mslOptions.force_active_argument_buffer_resources = false;
+                mslOptions.force_native_arrays = false;
+                mslOptions.enable_frag_depth_builtin = true;
+                mslOptions.enable_frag_stencil_ref_builtin = true;
+                mslOptions.enable_frag_output_mask = 0xffffffff;
+                mslOptions.enable_clip_distance_user_varying = true;
+                pMslCompiler->set_msl_options(mslOptions);
+            }
+            else if (sourceLanguage == SpvSourceLanguageHLSL)
+            {
+                pCompiler.reset(new spirv_cross::CompilerHLSL(std::move(parsedIr)));
+            }
+            else
+            {
+                if (sourceLanguage == SpvSourceLanguageVulkan)
+                {
+                    combineImageSamplers = false;
+                }
+                else
+                {
+                    buildDummySampler = true;
+                }
+                pCompiler.reset(new spirv_cross::CompilerGLSL(std::move(parsedIr)));
+            }
+
+            spirv_cross::CompilerGLSL::Options commonOptions = pCompiler->get_common_options();
+            if (sourceLanguage == SpvSourceLanguageESSL)
+            {
+                commonOptions.es = true;
+            }
+            if (version != 0)
+            {
+                commonOptions.version = version;
+            }
+            commonOptions.force_temporary = false;
+            commonOptions.separate_shader_objects = false;
+            commonOptions.flatten_multidimensional_arrays = false;
+            commonOptions.enable_420pack_extension = true;
+            commonOptions.vulkan_semantics = true;
+            commonOptions.vertex.fixup_clipspace = false;
+            commonOptions.vertex.flip_vert_y = false;
+            commonOptions.vertex.support_nonzero_base_instance = true;
+            commonOptions.emit_push_constant_as_uniform_buffer = false;
+            commonOptions.emit_uniform_buffer_as_plain_uniforms = false;
+            commonOptions.emit_line_directives = false;
+            commonOptions.enable_storage_image_qualifier_deduction = true;
+            commonOptions.force_zero_initialized_variables = false;
+            pCompiler->set_common_options(commonOptions);
+
+            if (sourceLanguage == SpvSourceLanguageHLSL)
+            {
+                auto* pHlslCompiler = static_cast<spirv_cross::CompilerHLSL*>(pCompiler.get());
+                auto hlslOptions = pHlslCompiler->get_hlsl_options();
+                if (version != 0)
+                {
+                    hlslOptions.shader_model = version;
+                }
+                hlslOptions.support_nonzero_base_vertex_base_instance = false;
+                hlslOptions.force_storage_buffer_as_uav = false;
+                hlslOptions.nonwritable_uav_texture_as_srv = false;
+                hlslOptions.enable_16bit_types = false;
+                pHlslCompiler->set_hlsl_options(hlslOptions);
+
+                pHlslCompiler->set_resource_binding_flags(0);
+            }
+
+            if (buildDummySampler)
+            {
+                uint32_t sampler = pCompiler->build_dummy_sampler_for_combined_images();
+                if (sampler != 0)
+                {
+                    // Set some defaults to make validation happy.
+                    pCompiler->set_decoration(sampler, DecorationDescriptorSet, 0);
+                    pCompiler->set_decoration(sampler, DecorationBinding, 0);
+                }
+            }
+
+            if (combineImageSamplers)
+            {
+                pCompiler->build_combined_image_samplers();
+            }
+
+            if (sourceLanguage == SpvSourceLanguageHLSL)
+            {
+                auto* pHlslCompiler = static_cast<spirv_cross::CompilerHLSL*>(pCompiler.get());
+                uint32_t newBuiltin = pHlslCompiler->remap_num_workgroups_builtin();
+                if (newBuiltin != 0)
+                {
+                    pHlslCompiler->set_decoration(newBuiltin, DecorationDescriptorSet, 0);
+                    pHlslCompiler->set_decoration(newBuiltin, DecorationBinding, 0);
+                }
+            }
+            sourceString = pCompiler->compile();
         }
-    case SpvGenVersionSpvGen:
+        catch (const std::bad_alloc&)
         {
-            *pVersion = SPVGEN_VERSION;
-            *pReversion = SPVGEN_REVISION;
-            break;
+            // SPIRV-Cross is built with exceptions, so an exhausted heap only fails the conversion
+            sourceString.clear();
+            success = false;
+            if (logSize > 0)
+            {
+                Snprintf(pLog, logSize, "error: out of memory, the conversion was aborted\n");
+            }
         }
-    default:
+        catch (const std::exception& e)
         {
-            result = false;
-            break;
+            if (logSize > 0)
+            {
+                Snprintf(pLog, logSize, "error: SPIRV-Cross threw an exception: %s\n", e.what());
+            }
+            success = false;
+        }
+    }
+
+    if (SpvMemoryTracker::IsCurrentBudgetExceeded())
+    {
+        sourceString.clear();
+        success = false;
+        if (logSize > 0)
+        {
+            Snprintf(pLog,
+                     logSize,
+                     "error: memory budget of %llu bytes exceeded, the conversion was aborted\n",
+                     static_cast<unsigned long long>(SpvMemoryTracker::GetCurrent()->GetBudget()));
+        }
+    }
+
+    size_t sourceStringSize = sourceString.length() + 1;
+    *ppSourceString = static_cast<char*>(AllocateBuffer(GetAllocator(pAllocator), sourceStringSize));
+    if (*ppSourceString == nullptr)
+    {
+        if (logSize > 0)
+        {
+            Snprintf(pLog, logSize, "error: failed to allocate the output buffer\n");
+        }
+        return false;
+    }
+    memcpy(*ppSourceString, sourceString.c_str(), sourceStringSize);
+    return success;
+}
+
+// =====================================================================================================================
+// convert SPIR-V binary token to other shader languages using Khronos SPIRV-Cross, the output string is allocated with
+// the specified allocator.
+//
+// NOTE: If pAllocator is null, the global allocator set by spvSetAllocationCallbacks is used. A string allocated by a
+// caller-supplied allocator is owned by the caller and must be released with the same allocator. If the memory budget
+// of the calling thread is exceeded, the conversion fails with an empty string.
+bool SH_IMPORT_EXPORT spvCrossSpirvWithAllocator(
+    SpvSourceLanguage             sourceLanguage,
+    uint32_t                      version,
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    char**                        ppSourceString,
+    const SpvAllocationCallbacks* pAllocator)
+{
+    SpvMemoryTracker tracker(ThreadMemoryBudget);
+    bool success = false;
+    char log[512] = {};
+    {
+        SpvMemoryScope memoryScope(&tracker);
+        success = CrossSpirv(sourceLanguage,
+                             version,
+                             size,
+                             pSpvToken,
+                             nullptr,
+                             ppSourceString,
+                             sizeof(log),
+                             log,
+                             pAllocator);
+    }
+    PublishMemoryStats(tracker);
+
+    if (log[0] != '\0')
+    {
+        // This call has no log, the failure is reported on the console
+        printf("%s", log);
+    }
+
+    return success && (tracker.IsBudgetExceeded() == false);
+}
+
+// =====================================================================================================================
+// Parse SPIR-V binary token with Khronos SPIRV-Cross once, so that it can be converted to any number of shader
+// languages by spvCrossSpirvFromParsed and spvCrossSpirvTargetsFromParsed without being parsed again. Returns false if
+// the binary can't be parsed.
+//
+// NOTE: *phParsedSpirv must be destroyed by spvCrossDestroyParsedSpirv. It is never modified after the parse, so it may
+// be converted by several threads at the same time.
+bool SH_IMPORT_EXPORT spvCrossParseSpirv(
+    unsigned int size,
+    const void*  pSpvToken,
+    void**       phParsedSpirv)   // [out] Parsed module, null on failure
+{
+    SpvMemoryTracker tracker(ThreadMemoryBudget);
+    bool success = false;
+    *phParsedSpirv = nullptr;
+    {
+        SpvMemoryScope memoryScope(&tracker);
+        try
+        {
+            // The parser copies the words into the IR, the caller's binary isn't referenced after the call
+            spirv_cross::Parser spvParser(static_cast<const uint32_t*>(pSpvToken), size / sizeof(uint32_t));
+            spvParser.parse();
+            *phParsedSpirv = new spirv_cross::ParsedIR(std::move(spvParser.get_parsed_ir()));
+            success = true;
+        }
+        catch (const std::exception&)
+        {
+            // The binary isn't valid SPIR-V, or the heap is exhausted
+        }
+
+        if (success && tracker.IsBudgetExceeded())
+        {
+            // The parse exceeded the memory budget of the call
+            delete reinterpret_cast<spirv_cross::ParsedIR*>(*phParsedSpirv);
+            *phParsedSpirv = nullptr;
+            success = false;
         }
     }
+    PublishMemoryStats(tracker);
+
+    return success;
+}
+
+// =====================================================================================================================
+// Convert a module parsed by spvCrossParseSpirv to another shader language, see spvCrossSpirvWithAllocator for the
+// version and the allocator
+bool SH_IMPORT_EXPORT spvCrossSpirvFromParsed(
+    void*                         hParsedSpirv,
+    SpvSourceLanguage             sourceLanguage,
+    uint32_t                      version,
+    char**                        ppSourceString,
+    unsigned int                  logSize,
+    char*                         pLog,         // [out] Error of a failure, may be null if logSize is 0
+    const SpvAllocationCallbacks* pAllocator)
+{
+    const spirv_cross::ParsedIR* pParsedIr = reinterpret_cast<const spirv_cross::ParsedIR*>(hParsedSpirv);
+    SpvMemoryTracker tracker(ThreadMemoryBudget);
+    bool success = false;
+    {
+        SpvMemoryScope memoryScope(&tracker);
+        success = CrossSpirv(sourceLanguage, version, 0, nullptr, pParsedIr, ppSourceString, logSize, pLog, pAllocator);
+    }
+    PublishMemoryStats(tracker);
 
-    return result;
+    return success && (tracker.IsBudgetExceeded() == false);
 }
 
 // =====================================================================================================================
-// Assemble SPIR-V text, store the result in pBuffer and return SPIRV code size in byte
+// Convert a module parsed by spvCrossParseSpirv to several shader languages or versions concurrently on the worker
+// thread pool, returns true if all targets are converted successfully
 //
-// NOTE: If assemble success, *ppLog is nullptr, otherwise, *ppLog is the error message and -1 is returned.
-int SH_IMPORT_EXPORT spvAssembleSpirv(
-    const char*    pSpvText,
-    unsigned int   bufSize,
-    unsigned int*  pBuffer,
-    const char**   ppLog)
+// NOTE: Every target works on a copy of the parsed module. The output string of each target must be released like the
+// output of spvCrossSpirvWithAllocator, it is also allocated for a failed target.
+bool SH_IMPORT_EXPORT spvCrossSpirvTargetsFromParsed(
+    void*                         hParsedSpirv,
+    int                           targetCount,
+    SpvCrossTarget*               pTargets,     // [in,out] Targets of the conversion
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator of the output strings, may be null
 {
-    int retval = -1;
+    const spirv_cross::ParsedIR* pParsedIr = reinterpret_cast<const spirv_cross::ParsedIR*>(hParsedSpirv);
+    for (int i = 0; i < targetCount; ++i)
+    {
+        pTargets[i].pSourceString = nullptr;
+        pTargets[i].success = false;
+    }
 
-    uint32_t options = SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS;
-    spv_binary binary;
-    spv_diagnostic diagnostic = nullptr;
-    spv_context context = spvContextCreate(GetSpirvTargetEnv(pSpvText));
-    spv_result_t result = spvTextToBinaryWithOptions(context, pSpvText,
-                                                     strlen(pSpvText), options, &binary, &diagnostic);
-    spvContextDestroy(context);
-    if (result == SPV_SUCCESS)
+    SpvMemoryTracker tracker(ThreadMemoryBudget);
+    std::atomic<bool> allSucceeded(true);
     {
-        unsigned int codeSize = static_cast<unsigned int>(binary->wordCount * sizeof(uint32_t));
-        if (codeSize > bufSize)
+        SpvMemoryScope memoryScope(&tracker);
+        SpvTaskGroup crossGroup(SpvThreadPool::GetDefault());
+        for (int i = 0; i < targetCount; ++i)
         {
-            codeSize = bufSize;
+            crossGroup.Run([&, i]()
+                {
+                    SpvCrossTarget& target = pTargets[i];
+                    target.success = CrossSpirv(target.sourceLanguage,
+                                                target.version,
+                                                0,
+                                                nullptr,
+                                                pParsedIr,
+                                                &target.pSourceString,
+                                                target.logSize,
+                                                target.pLog,
+                                                pAllocator);
+                    if (target.success == false)
+                    {
+                        allSucceeded = false;
+                    }
+                });
         }
-        memcpy(pBuffer, binary->code, codeSize);
-        *ppLog = nullptr;
-        retval = codeSize;
-        spvBinaryDestroy(binary);
+        crossGroup.Wait();
     }
-    else
+    PublishMemoryStats(tracker);
+
+    return allSucceeded && (tracker.IsBudgetExceeded() == false);
+}
+
+// =====================================================================================================================
+// Release a module parsed by spvCrossParseSpirv
+void SH_IMPORT_EXPORT spvCrossDestroyParsedSpirv(
+    void* hParsedSpirv)
+{
+    delete reinterpret_cast<spirv_cross::ParsedIR*>(hParsedSpirv);
+}
+
+// =====================================================================================================================
+// Convert a batch of SPIR-V binaries to other shader languages on the worker thread pool, returns true if all binaries
+// are converted successfully
+//
+// NOTE: Every item is parsed and converted by SPIRV-Cross objects of its own and runs with the memory budget of the
+// calling thread. A failure is only reported in the log of its item. The output string of each item must be released
+// like the output of spvCrossSpirvWithAllocator, it is also allocated for a failed item.
+bool SH_IMPORT_EXPORT spvCrossSpirvBatch(
+    int                           itemCount,
+    SpvCrossBatchItem*            pItems,       // [in,out] Items of the batch
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator of the output strings, may be null
+{
+    std::atomic<bool> allSucceeded(true);
+    const uint64_t memoryBudget = ThreadMemoryBudget;
+
+    SpvTaskGroup batchGroup(SpvThreadPool::GetDefault());
+    for (int i = 0; i < itemCount; ++i)
     {
-        *ppLog = reinterpret_cast<const char*>(pBuffer);
-        spvDiagnosticPrint(diagnostic, reinterpret_cast<char*>(pBuffer), static_cast<size_t>(bufSize));
-        spvDiagnosticDestroy(diagnostic);
-        retval = -1;
+        batchGroup.Run([&, i]()
+            {
+                SpvCrossBatchItem& item = pItems[i];
+                SpvMemoryTracker tracker(memoryBudget);
+                {
+                    SpvMemoryScope memoryScope(&tracker);
+                    item.success = CrossSpirv(item.sourceLanguage,
+                                              item.version,
+                                              item.size,
+                                              item.pSpvToken,
+                                              nullptr,
+                                              &item.pSourceString,
+                                              item.logSize,
+                                              item.pLog,
+                                              pAllocator);
+                }
+                if (tracker.IsBudgetExceeded())
+                {
+                    item.success = false;
+                }
+                if (item.success == false)
+                {
+                    allSucceeded = false;
+                }
+            });
     }
+    batchGroup.Wait();
 
-    return retval;
+    return allSucceeded;
 }
 
 // =====================================================================================================================
-// Disassemble SPIR-V binary token using khronos spirv-tools, and store the output text to pBuffer
+// Validate SPIR-V binary token using khronos spirv-tools, and store the log text to pLog
 //
 // NOTE: The text will be clampped if buffer size is less than requirement.
-bool SH_IMPORT_EXPORT spvDisassembleSpirv(
+bool SH_IMPORT_EXPORT spvValidateSpirv(
     unsigned int   size,
     const void*    pSpvToken,
-    unsigned int   bufSize,
-    char*          pBuffer)
+    unsigned int   logSize,
+    char*          pLog)
 {
-    uint32_t options = SPV_BINARY_TO_TEXT_OPTION_INDENT | SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
-    // If printing to standard output, then spvBinaryToText should
-    // do the printing.  In particular, colour printing on Windows is
-    // controlled by modifying console objects synchronously while
-    // outputting to the stream rather than by injecting escape codes
-    // into the output stream.
-    // If the printing option is off, then save the text in memory, so
-    // it can be emitted later in this function.
-    spv_text text = nullptr;
+    spv_const_binary_t binary =
+    {
+        reinterpret_cast<const uint32_t*>(pSpvToken),
+        static_cast<size_t>(size) / sizeof(uint32_t)
+    };
+
     spv_diagnostic diagnostic = nullptr;
-    spv_context context = spvContextCreate(GetSpirvTargetEnv(static_cast<const uint32_t*>(pSpvToken)));
-    spv_result_t result =
-        spvBinaryToText(context, reinterpret_cast<const uint32_t*>(pSpvToken),
-                        static_cast<const size_t>(size) / sizeof(uint32_t),
-                        options, &text, &diagnostic);
-    spvContextDestroy(context);
+    spv_context context = GetSpirvToolsContext(GetSpirvTargetEnv(static_cast<const uint32_t*>(pSpvToken)));
+    spv_result_t result = spvValidate(context, &binary, &diagnostic);
     bool success = (result == SPV_SUCCESS);
-    if (success)
-    {
-        unsigned int textSize = (unsigned int)(text->length);
-        memcpy(pBuffer, text->str, textSize);
-        pBuffer[textSize] = '\0';
-    }
-    else
+    if (success == false)
     {
-        spvDiagnosticPrint(diagnostic, pBuffer, bufSize);
+        spvDiagnosticPrint(diagnostic, pLog, logSize);
         spvDiagnosticDestroy(diagnostic);
     }
 
-    spvTextDestroy(text);
     return success;
 }
 
 // =====================================================================================================================
-// convert SPIR-V binary token to GLSL using Khronos SPIRV-Cross,
-//
-// NOTE: ppGlslSource should be freed by spvFreeBuffer
-bool SH_IMPORT_EXPORT spvCrossSpirv(
-    SpvSourceLanguage   sourceLanguage,
-    unsigned int        size,
-    const void*         pSpvToken,
-    char**              ppSourceString)
+// Get the number of SPIRV-Tools contexts created so far by spvAssembleSpirv, spvDisassembleSpirv and spvValidateSpirv.
+// The contexts are shared per SPIR-V target environment, so the count stays at the number of distinct SPIR-V versions
+// seen, unless several threads race to create the same context.
+uint64_t SH_IMPORT_EXPORT spvGetSpirvToolsContextCount()
 {
-    return spvCrossSpirvEx(sourceLanguage, 0, size, pSpvToken, ppSourceString);
+    return SpirvToolsContextCreateCount;
 }
 
 // =====================================================================================================================
-// convert SPIR-V binary token to other shader languages using Khronos SPIRV-Cross,
-//
-// NOTE: ppGlslSource should be freed by spvFreeBuffer
-// You need to calculate the version number of sourceLanguage; if version is set to 0, will use the default version (GLSL 450).
-// For HLSL, the default version is 30 (shader model 3); version = major * 10 + minor;
-// For MSL, the default version is 1.2; use make_msl_version to calculate the version number: version = (major * 10000) + (minor * 100) + patch;
-bool SH_IMPORT_EXPORT spvCrossSpirvEx(
-    SpvSourceLanguage   sourceLanguage,
-    uint32_t            version,
-    unsigned int        size,
-    const void*         pSpvToken,
-    char**              ppSourceString)
+// Disassemble SPIR-V binary token, and store the null terminated text in a buffer of the exact size allocated with
+// pAllocator (the global allocator if it is null)
+static bool DisassembleSpirvToBuffer(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    unsigned int*                 pBufSize,
+    void**                        ppBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator)
 {
-    bool success = true;
-    std::string sourceString = "";
-    try
+    std::string text;
+    auto output = [&text](const char* pText, size_t length)
+        {
+            text.append(pText, length);
+            return true;
+        };
+
+    spv_diagnostic diagnostic = nullptr;
+    bool success = (DisassembleSpirv(size, pSpvToken, output, &diagnostic) == SPV_SUCCESS);
+    *pBufSize = 0;
+    *ppBuf = nullptr;
+    if (logSize > 0)
     {
-        std::vector<uint32_t> spvBinary(size / sizeof(uint32_t));
-        memcpy(spvBinary.data(), pSpvToken, size);
-        spirv_cross::Parser spvParser(std::move(spvBinary));
-        spvParser.parse();
+        pLog[0] = '\0';
+    }
 
-        bool combineImageSamplers = false;
-        bool buildDummySampler = false;
-        std::unique_ptr<spirv_cross::CompilerGLSL> pCompiler;
-        if (sourceLanguage == SpvSourceLanguageMSL)
+    if (success)
+    {
+        const unsigned int textSize = static_cast<unsigned int>(text.size() + 1);
+        *ppBuf = AllocateBuffer(GetAllocator(pAllocator), textSize);
+        if (*ppBuf != nullptr)
         {
-            pCompiler.reset(new spirv_cross::CompilerMSL(std::move(spvParser.get_parsed_ir())));
-            auto* pMslCompiler = static_cast<spirv_cross::CompilerMSL*>(pCompiler.get());
-            auto mslOptions = pMslCompiler->get_msl_options();
-            if (version != 0)
-            {
-                mslOptions.msl_version = version;
-            }
-            mslOptions.capture_output_to_buffer = false;
-            mslOptions.swizzle_texture_samples = false;
-            mslOptions.invariant_float_math = false;
-            mslOptions.pad_fragment_output_components = false;
-            mslOptions.tess_domain_origin_lower_left = false;
-            mslOptions.argument_buffers = false;
-            mslOptions.argument_buffers = false;
-            mslOptions.texture_buffer_native = false;
-            mslOptions.multiview = false;
-            mslOptions.view_index_from_device_index = false;
-            mslOptions.dispatch_base = false;
-            mslOptions.enable_decoration_binding = false;
-            mslOptions.force_active_argument_buffer_resources = false;
-            mslOptions.force_native_arrays = false;
-            mslOptions.enable_frag_depth_builtin = true;
-            mslOptions.enable_frag_stencil_ref_builtin = true;
-            mslOptions.enable_frag_output_mask = 0xffffffff;
-            mslOptions.enable_clip_distance_user_varying = true;
-            pMslCompiler->set_msl_options(mslOptions);
-        }
-        else if (sourceLanguage == SpvSourceLanguageHLSL)
-        {
-            pCompiler.reset(new spirv_cross::CompilerHLSL(std::move(spvParser.get_parsed_ir())));
+            memcpy(*ppBuf, text.c_str(), textSize);
+            *pBufSize = textSize;
         }
         else
         {
-            if (sourceLanguage == SpvSourceLanguageVulkan)
-            {
-                combineImageSamplers = false;
-            }
-            else
+            if (logSize > 0)
             {
-                buildDummySampler = true;
+                Snprintf(pLog, logSize, "error: failed to allocate the output buffer\n");
             }
-            pCompiler.reset(new spirv_cross::CompilerGLSL(std::move(spvParser.get_parsed_ir())));
+            success = false;
         }
+    }
+    else if (logSize > 0)
+    {
+        spvDiagnosticPrint(diagnostic, pLog, logSize);
+    }
+    spvDiagnosticDestroy(diagnostic);
 
-        spirv_cross::CompilerGLSL::Options commonOptions = pCompiler->get_common_options();
-        if (sourceLanguage == SpvSourceLanguageESSL)
-        {
-            commonOptions.es = true;
-        }
-        if (version != 0)
-        {
-            commonOptions.version = version;
-        }
-        commonOptions.force_temporary = false;
-        commonOptions.separate_shader_objects = false;
-        commonOptions.flatten_multidimensional_arrays = false;
-        commonOptions.enable_420pack_extension = true;
-        commonOptions.vulkan_semantics = true;
-        commonOptions.vertex.fixup_clipspace = false;
-        commonOptions.vertex.flip_vert_y = false;
-        commonOptions.vertex.support_nonzero_base_instance = true;
-        commonOptions.emit_push_constant_as_uniform_buffer = false;
-        commonOptions.emit_uniform_buffer_as_plain_uniforms = false;
-        commonOptions.emit_line_directives = false;
-        commonOptions.enable_storage_image_qualifier_deduction = true;
-        commonOptions.force_zero_initialized_variables = false;
-        pCompiler->set_common_options(commonOptions);
+    return success;
+}
 
-        if (sourceLanguage == SpvSourceLanguageHLSL)
-        {
-            auto* pHlslCompiler = static_cast<spirv_cross::CompilerHLSL*>(pCompiler.get());
-            auto hlslOptions = pHlslCompiler->get_hlsl_options();
-            if (version != 0)
+// =====================================================================================================================
+// Run a SPIRV-Tools operation on every item of a batch on the worker thread pool, returns true if all items succeed
+template<typename ProcessItem>
+static bool RunSpirvToolsBatch(
+    int                itemCount,
+    SpvToolsBatchItem* pItems,
+    ProcessItem        processItem)   // Processes one item, returns its success
+{
+    std::atomic<bool> allSucceeded(true);
+
+    SpvTaskGroup batchGroup(SpvThreadPool::GetDefault());
+    for (int i = 0; i < itemCount; ++i)
+    {
+        batchGroup.Run([&, i]()
             {
-                hlslOptions.shader_model = version;
-            }
-            hlslOptions.support_nonzero_base_vertex_base_instance = false;
-            hlslOptions.force_storage_buffer_as_uav = false;
-            hlslOptions.nonwritable_uav_texture_as_srv = false;
-            hlslOptions.enable_16bit_types = false;
-            pHlslCompiler->set_hlsl_options(hlslOptions);
+                SpvToolsBatchItem& item = pItems[i];
+                item.success = processItem(item);
+                if (item.success == false)
+                {
+                    allSucceeded = false;
+                }
+            });
+    }
+    batchGroup.Wait();
 
-            pHlslCompiler->set_resource_binding_flags(0);
-        }
+    return allSucceeded;
+}
 
-        if (buildDummySampler)
+// =====================================================================================================================
+// Assemble a batch of SPIR-V texts on the worker thread pool, returns true if all texts are assembled successfully
+//
+// NOTE: The input of an item is the text, which doesn't have to be null terminated. The output of an item is allocated
+// with the exact size of its binary, see spvAssembleSpirvWithAllocator.
+bool SH_IMPORT_EXPORT spvAssembleSpirvBatch(
+    int                           itemCount,
+    SpvToolsBatchItem*            pItems,       // [in,out] Items of the batch
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator of the outputs, may be null
+{
+    return RunSpirvToolsBatch(itemCount, pItems, [pAllocator](SpvToolsBatchItem& item)
         {
-            uint32_t sampler = pCompiler->build_dummy_sampler_for_combined_images();
-            if (sampler != 0)
-            {
-                // Set some defaults to make validation happy.
-                pCompiler->set_decoration(sampler, DecorationDescriptorSet, 0);
-                pCompiler->set_decoration(sampler, DecorationBinding, 0);
-            }
-        }
+            return AssembleSpirvToBuffer(static_cast<const char*>(item.pInput),
+                                         item.inputSize,
+                                         &item.outputSize,
+                                         &item.pOutput,
+                                         item.logSize,
+                                         item.pLog,
+                                         pAllocator);
+        });
+}
 
-        if (combineImageSamplers)
+// =====================================================================================================================
+// Disassemble a batch of SPIR-V binaries on the worker thread pool, returns true if all binaries are disassembled
+// successfully
+//
+// NOTE: The output of an item is its null terminated text, allocated with the exact size. It should be freed by
+// spvFreeBuffer, or by the pfnFree callback of pAllocator if it isn't null.
+bool SH_IMPORT_EXPORT spvDisassembleSpirvBatch(
+    int                           itemCount,
+    SpvToolsBatchItem*            pItems,       // [in,out] Items of the batch
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator of the outputs, may be null
+{
+    return RunSpirvToolsBatch(itemCount, pItems, [pAllocator](SpvToolsBatchItem& item)
         {
-            pCompiler->build_combined_image_samplers();
-        }
+            return DisassembleSpirvToBuffer(static_cast<unsigned int>(item.inputSize),
+                                            item.pInput,
+                                            &item.outputSize,
+                                            &item.pOutput,
+                                            item.logSize,
+                                            item.pLog,
+                                            pAllocator);
+        });
+}
 
-        if (sourceLanguage == SpvSourceLanguageHLSL)
+// =====================================================================================================================
+// Validate a batch of SPIR-V binaries on the worker thread pool, returns true if all binaries are valid
+//
+// NOTE: Validation has no output, pOutput and outputSize of the items are cleared.
+bool SH_IMPORT_EXPORT spvValidateSpirvBatch(
+    int                itemCount,
+    SpvToolsBatchItem* pItems)   // [in,out] Items of the batch
+{
+    return RunSpirvToolsBatch(itemCount, pItems, [](SpvToolsBatchItem& item)
         {
-            auto* pHlslCompiler = static_cast<spirv_cross::CompilerHLSL*>(pCompiler.get());
-            uint32_t newBuiltin = pHlslCompiler->remap_num_workgroups_builtin();
-            if (newBuiltin != 0)
-            {
-                pHlslCompiler->set_decoration(newBuiltin, DecorationDescriptorSet, 0);
-                pHlslCompiler->set_decoration(newBuiltin, DecorationBinding, 0);
-            }
-        }
-        sourceString = pCompiler->compile();
+            item.pOutput = nullptr;
+            item.outputSize = 0;
+            return spvValidateSpirv(static_cast<unsigned int>(item.inputSize), item.pInput, item.logSize, item.pLog);
+        });
+}
 
-    }
-    catch(const std::exception& e)
+// =====================================================================================================================
+// Compute the canonical 128-bit fingerprint of SPIR-V binary token, returns false if the binary is invalid. Modules
+// which only differ in ID numbering, in the order of their capabilities, entry-points, execution modes, debug names,
+// annotations and declarations, and with SpvFingerprintIgnoreDebugInfo in their debug instructions, get the same
+// fingerprint.
+//
+// NOTE: The fingerprint is stable across runs, so it may be used as the key of persistent caches.
+bool SH_IMPORT_EXPORT spvFingerprintSpirv(
+    unsigned int    size,
+    const void*     pSpvToken,
+    int             flags,          // Combination of SpvFingerprintFlags
+    SpvFingerprint* pFingerprint)   // [out] Fingerprint
+{
+    const uint32_t* pCode = static_cast<const uint32_t*>(pSpvToken);
+    const size_t wordCount = static_cast<size_t>(size) / sizeof(uint32_t);
+    if ((wordCount < 5) || (pCode[0] != spv::MagicNumber))
     {
-        printf("SPIRV-Cross threw an exception : %s\n", e.what());
-        assert(!e.what());
-        success = false;
+        return false;
     }
 
-    size_t sourceStringSize = sourceString.length() + 1;
-    *ppSourceString = static_cast<char*>(malloc(sourceStringSize));
-    memcpy(*ppSourceString, sourceString.c_str(), sourceStringSize);
-    return success;
+    SpvHash128 fingerprint = {};
+    spv_diagnostic diagnostic = nullptr;
+    spv_result_t result = FingerprintSpirv(GetSpirvToolsContext(GetSpirvTargetEnv(pCode)),
+                                           pCode,
+                                           wordCount,
+                                           (flags & SpvFingerprintIgnoreDebugInfo) != 0,
+                                           &fingerprint,
+                                           &diagnostic);
+    spvDiagnosticDestroy(diagnostic);
+
+    pFingerprint->low = fingerprint.lo;
+    pFingerprint->high = fingerprint.hi;
+    return (result == SPV_SUCCESS);
 }
 
 // =====================================================================================================================
-// Validate SPIR-V binary token using khronos spirv-tools, and store the log text to pLog
+// Copy one array of the reflection into the output buffer
+template<typename T>
+static const T* CopyReflectionArray(
+    const std::vector<T>& source,
+    uint8_t*              pBuffer,   // [out] Output buffer
+    size_t                offset,    // Offset of the array in the output buffer
+    uint32_t*             pCount)    // [out] Number of array elements
+{
+    T* pArray = reinterpret_cast<T*>(pBuffer + offset);
+    std::copy(source.begin(), source.end(), pArray);
+    *pCount = static_cast<uint32_t>(source.size());
+    return pArray;
+}
+
+// =====================================================================================================================
+// Reflect the descriptors, push constant blocks, stage inputs, specialization constants and workgroup size of SPIR-V
+// binary token in one pass over its global declarations, without cross-compiling it. Returns false if the binary is
+// invalid.
 //
-// NOTE: The text will be clampped if buffer size is less than requirement.
-bool SH_IMPORT_EXPORT spvValidateSpirv(
-    unsigned int   size,
-    const void*    pSpvToken,
-    unsigned int   logSize,
-    char*          pLog)
+// NOTE: *ppReflection is a single buffer which also holds the arrays it points to. It should be freed by
+// spvFreeBuffer, or by the pfnFree callback of pAllocator if it isn't null.
+bool SH_IMPORT_EXPORT spvReflectSpirv(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    SpvReflection**               ppReflection,   // [out] Reflected resources
+    const SpvAllocationCallbacks* pAllocator)     // [in] Allocator of the output buffer, may be null
 {
-    spv_const_binary_t binary =
+    *ppReflection = nullptr;
+    const uint32_t* pCode = static_cast<const uint32_t*>(pSpvToken);
+    const size_t wordCount = static_cast<size_t>(size) / sizeof(uint32_t);
+    if ((wordCount < 5) || (pCode[0] != spv::MagicNumber))
     {
-        reinterpret_cast<const uint32_t*>(pSpvToken),
-        static_cast<size_t>(size) / sizeof(uint32_t)
-    };
+        return false;
+    }
 
-    spv_diagnostic diagnostic = nullptr;
-    spv_context context = spvContextCreate(GetSpirvTargetEnv(static_cast<const uint32_t*>(pSpvToken)));
-    spv_result_t result = spvValidate(context, &binary, &diagnostic);
-    spvContextDestroy(context);
-    bool success = (result == SPV_SUCCESS);
-    if (success == false)
+    SpvReflectionData data;
+    if (ReflectSpirv(pCode, wordCount, &data) == false)
     {
-        spvDiagnosticPrint(diagnostic, pLog, logSize);
-        spvDiagnosticDestroy(diagnostic);
+        return false;
     }
 
-    return success;
+    // The arrays follow the structure, the 8-byte aligned one first so that none of them needs padding
+    const size_t specConstantsOffset = sizeof(SpvReflection);
+    const size_t descriptorsOffset = specConstantsOffset + data.specConstants.size() * sizeof(SpvReflectSpecConstant);
+    const size_t inputsOffset = descriptorsOffset + data.descriptors.size() * sizeof(SpvReflectDescriptor);
+    const size_t pushConstantsOffset = inputsOffset + data.inputs.size() * sizeof(SpvReflectInput);
+    const size_t bufferSize = pushConstantsOffset + data.pushConstants.size() * sizeof(SpvReflectPushConstant);
+
+    uint8_t* pBuffer = static_cast<uint8_t*>(AllocateBuffer(GetAllocator(pAllocator), bufferSize));
+    if (pBuffer == nullptr)
+    {
+        return false;
+    }
+
+    SpvReflection* pReflection = reinterpret_cast<SpvReflection*>(pBuffer);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        pReflection->workgroupSize[i] = data.workgroupSize[i];
+        pReflection->workgroupSizeSpecIds[i] = data.workgroupSizeSpecIds[i];
+    }
+    pReflection->pSpecConstants =
+        CopyReflectionArray(data.specConstants, pBuffer, specConstantsOffset, &pReflection->specConstantCount);
+    pReflection->pDescriptors =
+        CopyReflectionArray(data.descriptors, pBuffer, descriptorsOffset, &pReflection->descriptorCount);
+    pReflection->pInputs = CopyReflectionArray(data.inputs, pBuffer, inputsOffset, &pReflection->inputCount);
+    pReflection->pPushConstants =
+        CopyReflectionArray(data.pushConstants, pBuffer, pushConstantsOffset, &pReflection->pushConstantCount);
+
+    *ppReflection = pReflection;
+    return true;
 }
 
 // =====================================================================================================================
@@ -1474,6 +4289,31 @@ bool SH_IMPORT_EXPORT spvOptimizeSpirv(
     void**         ppOptBuf,
     unsigned int   logSize,
     char*          pLog)
+{
+    return spvOptimizeSpirvWithAllocator(size,
+                                         pSpvToken,
+                                         optionCount,
+                                         options,
+                                         pBufSize,
+                                         ppOptBuf,
+                                         logSize,
+                                         pLog,
+                                         nullptr);
+}
+
+// =====================================================================================================================
+// Optimize SPIR-V binary token using khronos spirv-tools, the optimized result is allocated with the specified
+// allocator.
+static bool OptimizeSpirv(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    int                           optionCount,
+    const char*                   options[],
+    unsigned int*                 pBufSize,
+    void**                        ppOptBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator)
 {
     std::string errorMsg;
     spvtools::Optimizer optimizer(GetSpirvTargetEnv(static_cast<const uint32_t*>(pSpvToken)));
@@ -1530,13 +4370,37 @@ bool SH_IMPORT_EXPORT spvOptimizeSpirv(
 
     std::vector<uint32_t> binary;
 
-    bool ret = optimizer.Run((const uint32_t*)pSpvToken, size / sizeof(uint32_t), &binary);
+    // The memory budget of the call is checked before and after the passes, the optimizer runs to its end
+    bool ret = false;
+    if (SpvMemoryTracker::IsCurrentBudgetExceeded() == false)
+    {
+        ret = optimizer.Run((const uint32_t*)pSpvToken, size / sizeof(uint32_t), &binary);
+    }
+
+    if (SpvMemoryTracker::IsCurrentBudgetExceeded())
+    {
+        ret = false;
+        char buffer[128];
+        Snprintf(buffer,
+                 sizeof(buffer),
+                 "error: memory budget of %llu bytes exceeded, the optimization was aborted\n",
+                 static_cast<unsigned long long>(SpvMemoryTracker::GetCurrent()->GetBudget()));
+        errorMsg += buffer;
+    }
 
     if (ret)
     {
         *pBufSize = static_cast<uint32_t>(binary.size() * sizeof(uint32_t));
-        *ppOptBuf = malloc(*pBufSize);
-        memcpy(*ppOptBuf, binary.data(), *pBufSize);
+        *ppOptBuf = AllocateBuffer(GetAllocator(pAllocator), *pBufSize);
+        if (*ppOptBuf != nullptr)
+        {
+            memcpy(*ppOptBuf, binary.data(), *pBufSize);
+        }
+        else
+        {
+            errorMsg += "error: failed to allocate the output buffer\n";
+            ret = false;
+        }
     }
 
     if (logSize > 0)
@@ -1554,12 +4418,93 @@ bool SH_IMPORT_EXPORT spvOptimizeSpirv(
     return ret;
 }
 
+// =====================================================================================================================
+// Optimize SPIR-V binary token using khronos spirv-tools, the optimized result is allocated with the specified
+// allocator.
+//
+// NOTE: If pAllocator is null, the global allocator set by spvSetAllocationCallbacks is used. A buffer allocated by a
+// caller-supplied allocator is owned by the caller and must be released with the same allocator. If the memory budget
+// of the calling thread is exceeded, the optimization fails with an error in the log.
+bool SH_IMPORT_EXPORT spvOptimizeSpirvWithAllocator(
+    unsigned int                  size,
+    const void*                   pSpvToken,
+    int                           optionCount,
+    const char*                   options[],
+    unsigned int*                 pBufSize,
+    void**                        ppOptBuf,
+    unsigned int                  logSize,
+    char*                         pLog,
+    const SpvAllocationCallbacks* pAllocator)
+{
+    SpvMemoryTracker tracker(ThreadMemoryBudget);
+    bool success = false;
+    {
+        SpvMemoryScope memoryScope(&tracker);
+        success = OptimizeSpirv(size, pSpvToken, optionCount, options, pBufSize, ppOptBuf, logSize, pLog, pAllocator);
+    }
+    PublishMemoryStats(tracker);
+
+    return success;
+}
+
 // =====================================================================================================================
 // Free input buffer
+//
+// NOTE: The buffer is released with the global allocator, so it must not be changed while buffers allocated with it
+// are alive.
 void SH_IMPORT_EXPORT spvFreeBuffer(
     void* pBuffer)
 {
-    free(pBuffer);
+    SpvAllocationCallbacks allocator = GetAllocator(nullptr);
+    if (allocator.pfnFree != nullptr)
+    {
+        if (pBuffer != nullptr)
+        {
+            allocator.pfnFree(allocator.pUserData, pBuffer);
+        }
+    }
+    else
+    {
+        free(pBuffer);
+    }
+}
+
+// =====================================================================================================================
+// Set the global allocator of the output buffers of spvOptimizeSpirv and spvCrossSpirv, null restores malloc/free
+void SH_IMPORT_EXPORT spvSetAllocationCallbacks(
+    const SpvAllocationCallbacks* pAllocator)   // [in] Allocator, both callbacks must be set
+{
+    std::lock_guard<std::mutex> guard(AllocatorLock);
+    if ((pAllocator != nullptr) && (pAllocator->pfnAllocation != nullptr) && (pAllocator->pfnFree != nullptr))
+    {
+        GlobalAllocator = *pAllocator;
+    }
+    else
+    {
+        GlobalAllocator = {};
+    }
+}
+
+// =====================================================================================================================
+// Set the memory budget of the calls made by the calling thread: spvCompileAndLinkProgram*, spvRecompileProgramStage,
+// spvOptimizeSpirv* and spvCrossSpirv*. A call which allocates more than the budget at the same time fails. The budget
+// is checked between the phases of the call, a phase which exceeds it still runs to its end, so the peak may exceed
+// the budget by the allocations of one phase. Batch and asynchronous compiles take the budget of the thread which
+// starts them.
+void SH_IMPORT_EXPORT spvSetMemoryBudget(
+    uint64_t maxBytes)   // Budget in bytes, 0 means no budget
+{
+    ThreadMemoryBudget = maxBytes;
+}
+
+// =====================================================================================================================
+// Get the memory statistics of the last spvCompileAndLinkProgram*, spvOptimizeSpirv* or spvCrossSpirv* call made by
+// the calling thread, returns false if the thread hasn't made such a call yet.
+bool SH_IMPORT_EXPORT spvGetLastMemoryStats(
+    SpvMemoryStats* pStats)   // [out] Memory statistics of the call
+{
+    *pStats = LastMemoryStats;
+    return LastMemoryStats.valid;
 }
 
 #if !defined _MSC_VER && !defined MINGW_HAS_SECURE_API
@@ -1632,6 +4577,21 @@ EShLanguage SpvGenStageToEShLanguage(
     }
 }
 
+// =====================================================================================================================
+// Convert EShLanguage enumerant to corresponding SpvGenStage enumerant, SpvGenStageInvalid if there is none.
+SpvGenStage EShLanguageToSpvGenStage(
+    EShLanguage stage) // EShLanguage enumerant
+{
+    for (uint32_t i = 0; i < SpvGenStageCount; ++i)
+    {
+        if (SpvGenStageToEShLanguage(static_cast<SpvGenStage>(i)) == stage)
+        {
+            return static_cast<SpvGenStage>(i);
+        }
+    }
+    return SpvGenStageInvalid;
+}
+
 // =====================================================================================================================
 // Malloc a string of sufficient size and read a string into it.
 bool ReadFileData(
@@ -1754,6 +4714,7 @@ static void internalInit()
 // Cleanup
 static void internalFinal()
 {
+    DestroySpirvToolsContexts();
     glslang::FinalizeProcess();
 }
 
@@ -1771,6 +4732,8 @@ bool InitSpvGen(const char* pSpvGenDir)
 // Finalize the static library
 void FinalizeSpvgen()
 {
+    SpvThreadPool::DestroyDefault();
+    DestroySpirvToolsContexts();
 #if defined(_WIN32)
     internalFinal();
 #endif
@@ -1810,6 +4773,9 @@ __attribute__((constructor)) static void Init()
 
 __attribute__((destructor)) static void Destroy()
 {
+    SpvThreadPool::DestroyDefault();
+    DestroySpirvToolsContexts();
+
     if (pConfigFile != nullptr)
     {
         delete pConfigFile;
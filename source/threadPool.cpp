@@ -0,0 +1,398 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  threadPool.cpp
+* @brief SPVGEN source file: contains the implementation of the internal worker thread pool.
+***********************************************************************************************************************
+*/
+#include "threadPool.h"
+#include "memoryTracker.h"
+
+#include <climits>
+#include <cstdint>
+#include <iterator>
+#include <new>
+
+static std::mutex     DefaultPoolLock;
+static SpvThreadPool* pDefaultPool = nullptr;
+static uint32_t       DefaultThreadCount = 0;
+
+// Pool and worker index of the current thread, if it is a worker thread
+static thread_local SpvThreadPool* pCurrentPool = nullptr;
+static thread_local uint32_t       CurrentWorkerIndex = 0;
+
+// =====================================================================================================================
+SpvThreadPool::SpvThreadPool(
+    uint32_t threadCount)   // Number of worker threads, 0 means one per hardware thread
+    :
+    queuedCount(0),
+    shutdown(false)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    workerQueues.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        workerQueues.emplace_back(new TaskQueue);
+    }
+
+    workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+// =====================================================================================================================
+SpvThreadPool::~SpvThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        shutdown = true;
+    }
+    wakeup.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// =====================================================================================================================
+// Queue a task to be run on one of the worker threads
+void SpvThreadPool::Submit(
+    Task                task,
+    const SpvTaskGroup* pGroup)   // [in] Group the task belongs to, may be null
+{
+    QueuedTask queuedTask = { std::move(task), SpvMemoryTracker::GetCurrent(), pGroup };
+
+    // The queue itself isn't accounted to the caller, its memory outlives the call
+    SpvMemoryScope untracked(nullptr);
+
+    // Count the task before it becomes visible, so that the count never drops below zero
+    ++queuedCount;
+
+    TaskQueue* pQueue = (pCurrentPool == this) ? workerQueues[CurrentWorkerIndex].get() : &sharedQueue;
+    try
+    {
+        std::lock_guard<std::mutex> guard(pQueue->lock);
+        pQueue->tasks.push_back(std::move(queuedTask));
+    }
+    catch (...)
+    {
+        // The queue couldn't grow, the task was never visible
+        --queuedCount;
+        throw;
+    }
+
+    // Taking the lock orders the increment above against the predicate check of a worker going to sleep
+    {
+        std::lock_guard<std::mutex> guard(lock);
+    }
+    wakeup.notify_one();
+}
+
+// =====================================================================================================================
+// Take one task from the queues, in the order: own queue (newest first), shared queue, other workers' queues (oldest
+// first). Returns false if all queues are empty.
+bool SpvThreadPool::PopTask(
+    uint32_t    workerIndex,   // Index of the calling worker, or UINT32_MAX if the caller isn't a worker of this pool
+    QueuedTask* pTask)         // [out] Task taken from the queues
+{
+    if (queuedCount == 0)
+    {
+        return false;
+    }
+
+    const uint32_t workerCount = static_cast<uint32_t>(workerQueues.size());
+    if (workerIndex < workerCount)
+    {
+        TaskQueue* pQueue = workerQueues[workerIndex].get();
+        std::lock_guard<std::mutex> guard(pQueue->lock);
+        if (pQueue->tasks.empty() == false)
+        {
+            *pTask = std::move(pQueue->tasks.back());
+            pQueue->tasks.pop_back();
+            --queuedCount;
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(sharedQueue.lock);
+        if (sharedQueue.tasks.empty() == false)
+        {
+            *pTask = std::move(sharedQueue.tasks.front());
+            sharedQueue.tasks.pop_front();
+            --queuedCount;
+            return true;
+        }
+    }
+
+    // Steal, starting from the next worker so that the victims are spread out
+    const uint32_t first = (workerIndex < workerCount) ? workerIndex + 1 : 0;
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        const uint32_t victim = (first + i) % workerCount;
+        if (victim == workerIndex)
+        {
+            continue;
+        }
+
+        TaskQueue* pQueue = workerQueues[victim].get();
+        std::lock_guard<std::mutex> guard(pQueue->lock);
+        if (pQueue->tasks.empty() == false)
+        {
+            *pTask = std::move(pQueue->tasks.front());
+            pQueue->tasks.pop_front();
+            --queuedCount;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// =====================================================================================================================
+// Take one task of the specified group from the queues, the own queue of a worker is searched first. Returns false if
+// the group has no queued task.
+bool SpvThreadPool::PopGroupTask(
+    const SpvTaskGroup* pGroup,   // [in] Group the task must belong to
+    QueuedTask*         pTask)    // [out] Task taken from the queues
+{
+    if (queuedCount == 0)
+    {
+        return false;
+    }
+
+    // Search the own queue of a worker first, the tasks of a group nested in a task usually stay there
+    const uint32_t workerCount = static_cast<uint32_t>(workerQueues.size());
+    const uint32_t first = (pCurrentPool == this) ? CurrentWorkerIndex : 0;
+    for (uint32_t i = 0; i <= workerCount; ++i)
+    {
+        TaskQueue* pQueue = (i < workerCount) ? workerQueues[(first + i) % workerCount].get() : &sharedQueue;
+        std::lock_guard<std::mutex> guard(pQueue->lock);
+        for (auto it = pQueue->tasks.rbegin(); it != pQueue->tasks.rend(); ++it)
+        {
+            if (it->pGroup == pGroup)
+            {
+                *pTask = std::move(*it);
+                pQueue->tasks.erase(std::next(it).base());
+                --queuedCount;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// =====================================================================================================================
+// Run one queued task of the specified group on the calling thread, returns false if the group has no queued task
+bool SpvThreadPool::RunPendingTask(
+    const SpvTaskGroup* pGroup)   // [in] Group the task must belong to
+{
+    QueuedTask task;
+    if (PopGroupTask(pGroup, &task) == false)
+    {
+        return false;
+    }
+
+    RunTask(&task);
+    return true;
+}
+
+// =====================================================================================================================
+// Run a task taken from the queues with the memory tracker of its submitter
+void SpvThreadPool::RunTask(
+    QueuedTask* pTask)   // [in] Task to run
+{
+    SpvMemoryScope memoryScope(pTask->pTracker);
+    pTask->task();
+    pTask->task = nullptr;
+}
+
+// =====================================================================================================================
+// Main loop of the worker threads
+void SpvThreadPool::WorkerLoop(
+    uint32_t workerIndex)   // Index of this worker
+{
+    pCurrentPool = this;
+    CurrentWorkerIndex = workerIndex;
+
+    while (true)
+    {
+        QueuedTask task;
+        if (PopTask(workerIndex, &task))
+        {
+            RunTask(&task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(lock);
+        wakeup.wait(guard, [this]() { return shutdown || (queuedCount != 0); });
+        if (shutdown && (queuedCount == 0))
+        {
+            // Shut down is only honored once the queues are drained
+            break;
+        }
+    }
+
+    pCurrentPool = nullptr;
+}
+
+// =====================================================================================================================
+// Get the process-wide pool shared by all entry-points, it is created on first use
+SpvThreadPool* SpvThreadPool::GetDefault()
+{
+    std::lock_guard<std::mutex> guard(DefaultPoolLock);
+    if (pDefaultPool == nullptr)
+    {
+        pDefaultPool = new SpvThreadPool(DefaultThreadCount);
+    }
+    return pDefaultPool;
+}
+
+// =====================================================================================================================
+// Set the number of worker threads of the process-wide pool, returns false if the pool already exists
+bool SpvThreadPool::SetDefaultThreadCount(
+    uint32_t threadCount)   // Number of worker threads, 0 means one per hardware thread
+{
+    std::lock_guard<std::mutex> guard(DefaultPoolLock);
+    if (pDefaultPool != nullptr)
+    {
+        return false;
+    }
+    DefaultThreadCount = threadCount;
+    return true;
+}
+
+// =====================================================================================================================
+// Destroy the process-wide pool, it is re-created on next use
+void SpvThreadPool::DestroyDefault()
+{
+    std::lock_guard<std::mutex> guard(DefaultPoolLock);
+    delete pDefaultPool;
+    pDefaultPool = nullptr;
+}
+
+// =====================================================================================================================
+SpvTaskGroup::SpvTaskGroup(
+    SpvThreadPool* pPool)   // [in] Pool the tasks of this group run on
+    :
+    pPool(pPool),
+    pendingCount(0),
+    submitCount(0)
+{
+}
+
+// =====================================================================================================================
+// Submit a task which belongs to this group
+void SpvTaskGroup::Run(
+    SpvThreadPool::Task task)
+{
+    // Wrap the task before it is counted, the wrapper may fail to allocate
+    SpvThreadPool::Task groupTask = [this, task = std::move(task)]()
+        {
+            try
+            {
+                task();
+            }
+            catch (const std::bad_alloc&)
+            {
+                // A task which ran out of memory still has to finish the group, or its Wait() never returns. The
+                // tasks of spvgen catch their own failures, this only covers an exhausted heap.
+            }
+
+            // Decrement under the lock so that the notification can't be lost between the check and the wait in
+            // Wait(), and so that Wait() can't return while this thread still touches the group.
+            std::lock_guard<std::mutex> guard(lock);
+            if (--pendingCount == 0)
+            {
+                done.notify_all();
+            }
+        };
+
+    ++pendingCount;
+    try
+    {
+        pPool->Submit(std::move(groupTask), this);
+    }
+    catch (...)
+    {
+        // The task never reached the pool, uncount it so that Wait() doesn't wait for it
+        std::lock_guard<std::mutex> guard(lock);
+        if (--pendingCount == 0)
+        {
+            done.notify_all();
+        }
+        throw;
+    }
+
+    // Wake up a waiting thread, it may run the new task itself
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ++submitCount;
+    }
+    done.notify_all();
+}
+
+// =====================================================================================================================
+// Wait until all tasks of this group are finished
+void SpvTaskGroup::Wait()
+{
+    while (pendingCount != 0)
+    {
+        uint64_t seenSubmitCount = 0;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            seenSubmitCount = submitCount;
+        }
+
+        // Only the tasks of this group are run while waiting: an unrelated task could take arbitrarily long, and
+        // could wait on a group of its own, nesting without bound on this stack.
+        if (pPool->RunPendingTask(this) == false)
+        {
+            // The remaining tasks are running on other threads. A task submitted after the queues were searched
+            // changes the submit count, so it isn't missed.
+            std::unique_lock<std::mutex> guard(lock);
+            done.wait(guard, [this, seenSubmitCount]()
+                {
+                    return (pendingCount == 0) || (submitCount != seenSubmitCount);
+                });
+        }
+    }
+
+    // Synchronize with the last finishing task before the group can be destroyed
+    std::lock_guard<std::mutex> guard(lock);
+}
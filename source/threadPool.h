@@ -0,0 +1,135 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2025 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  threadPool.h
+* @brief SPVGEN header file: contains the declaration of the internal worker thread pool.
+***********************************************************************************************************************
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SpvMemoryTracker;
+class SpvTaskGroup;
+
+// =====================================================================================================================
+// Represents a fixed-size pool of worker threads which run queued tasks.
+//
+// Every worker owns a task queue. Tasks submitted from a worker go to the back of its own queue and are taken from
+// the back again (LIFO, good cache locality for nested work), tasks submitted from other threads go to a shared queue.
+// An idle worker takes work from its own queue first, then from the shared queue, and finally steals from the front
+// of the other workers' queues.
+//
+// A task runs with the memory tracker which was current on the submitting thread, see SpvMemoryTracker.
+class SpvThreadPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    explicit SpvThreadPool(uint32_t threadCount);
+    ~SpvThreadPool();
+
+    // Queue a task to be run on one of the worker threads
+    void Submit(Task task, const SpvTaskGroup* pGroup = nullptr);
+
+    // Run one queued task of the specified group on the calling thread, returns false if the group has no queued task
+    bool RunPendingTask(const SpvTaskGroup* pGroup);
+
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(workers.size()); }
+
+    // Get the process-wide pool shared by all entry-points, it is created on first use
+    static SpvThreadPool* GetDefault();
+
+    // Set the number of worker threads of the process-wide pool, returns false if the pool already exists
+    static bool SetDefaultThreadCount(uint32_t threadCount);
+
+    // Destroy the process-wide pool, it is re-created on next use
+    static void DestroyDefault();
+
+private:
+    // Queued task, the memory tracker of the thread which submitted it and the group it belongs to
+    struct QueuedTask
+    {
+        Task                task;
+        SpvMemoryTracker*   pTracker;
+        const SpvTaskGroup* pGroup;     // Null if the task doesn't belong to a group
+    };
+
+    // Task queue with its own lock
+    struct TaskQueue
+    {
+        std::mutex             lock;
+        std::deque<QueuedTask> tasks;
+    };
+
+    void WorkerLoop(uint32_t workerIndex);
+    bool PopTask(uint32_t workerIndex, QueuedTask* pTask);
+    bool PopGroupTask(const SpvTaskGroup* pGroup, QueuedTask* pTask);
+    static void RunTask(QueuedTask* pTask);
+
+    std::vector<std::thread>                  workers;
+    std::vector<std::unique_ptr<TaskQueue>>   workerQueues;   // One queue per worker
+    TaskQueue                                 sharedQueue;    // Tasks submitted from outside of the pool
+    std::atomic<uint32_t>                     queuedCount;    // Number of tasks in all queues
+    std::mutex                                lock;           // Protects the sleep/wake-up of the workers
+    std::condition_variable                   wakeup;
+    bool                                      shutdown;
+};
+
+// =====================================================================================================================
+// Tracks a set of tasks submitted to a thread pool so that the caller can wait for all of them.
+//
+// NOTE: Wait() runs the queued tasks of its own group on the calling thread, and blocks once the remaining tasks are
+// running on other threads. So task groups may be nested inside pool tasks without starving the pool, and a waiting
+// thread never picks up unrelated work which would delay its return.
+class SpvTaskGroup
+{
+public:
+    explicit SpvTaskGroup(SpvThreadPool* pPool);
+    ~SpvTaskGroup() { Wait(); }
+
+    // Submit a task which belongs to this group. If it can't be queued the exception is passed on, and Wait() doesn't
+    // wait for it.
+    void Run(SpvThreadPool::Task task);
+
+    // Wait until all tasks of this group are finished
+    void Wait();
+
+private:
+    SpvThreadPool*            pPool;
+    std::atomic<uint32_t>     pendingCount;
+    uint64_t                  submitCount;    // Number of submitted tasks, protected by lock
+    std::mutex                lock;
+    std::condition_variable   done;           // Signaled when the last task finishes or a task is submitted
+};